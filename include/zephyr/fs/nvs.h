@@ -33,6 +33,22 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection statistics
+ */
+struct nvs_gc_stats {
+	/** Number of sectors garbage collected */
+	uint32_t gc_runs;
+	/** Number of data bytes moved by garbage collection */
+	uint32_t bytes_moved;
+	/** Number of background garbage collections completed by a writer */
+	uint32_t sync_copies;
+	/** Number of sector erases performed by a writer */
+	uint32_t sync_erases;
+	/** Worst-case time spent writing an entry, in microseconds */
+	uint32_t max_write_us;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  */
@@ -62,6 +78,32 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_ID_INDEX
+	/** ID index: NVS IDs and the address of their most recent ATE */
+	uint16_t id_index_ids[CONFIG_NVS_ID_INDEX_SIZE];
+	uint32_t id_index_addr[CONFIG_NVS_ID_INDEX_SIZE];
+	/** Number of IDs in the ID index */
+	uint16_t id_index_used;
+	/** Flag indicating if all IDs in the file system fit in the ID index */
+	bool id_index_complete;
+#endif
+#if CONFIG_NVS_BACKGROUND_GC
+	/** Background garbage collection work item */
+	struct k_work gc_work;
+	/** Sector being garbage collected */
+	uint32_t gc_sec_addr;
+	/** Next and last allocation table entry to garbage collect */
+	uint32_t gc_addr;
+	uint32_t gc_stop_addr;
+	/** Background garbage collection state */
+	uint8_t gc_state;
+	/** Flag indicating that no entry was written since the last gc */
+	bool gc_fresh;
+#endif
+#if CONFIG_NVS_GC_STATS
+	/** Garbage collection statistics */
+	struct nvs_gc_stats gc_stats;
+#endif
 };
 
 /**
@@ -164,6 +206,39 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+#if defined(CONFIG_NVS_BACKGROUND_GC) || defined(__DOXYGEN__)
+/**
+ * @brief Wait for the background garbage collection to be done.
+ *
+ * Returns once the background garbage collection has no more work
+ * pending, or has stopped on an error that the next write will report.
+ *
+ * @param fs Pointer to file system
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_wait(struct nvs_fs *fs);
+#endif
+
+#if defined(CONFIG_NVS_GC_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the garbage collection statistics of the file system.
+ *
+ * @param fs Pointer to file system
+ * @param stats Pointer to the structure to fill in
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats);
+
+/**
+ * @brief Reset the garbage collection statistics of the file system.
+ *
+ * @param fs Pointer to a mounted file system
+ */
+void nvs_gc_stats_reset(struct nvs_fs *fs);
+#endif
+
 /**
  * @}
  */
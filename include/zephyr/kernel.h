@@ -3602,6 +3602,53 @@ static inline k_ticks_t k_work_delayable_expires_get(
 static inline k_ticks_t k_work_delayable_remaining_get(
 	const struct k_work_delayable *dwork);
 
+/** @brief Set the timer slack of a delayable work item.
+ *
+ * Allows the submission of the work item after a delay to happen up to
+ * @p slack later than requested. The kernel uses this freedom to submit
+ * work items whose delays end close to each other on the same tick, so
+ * that they take a single timer wakeup rather than one each.
+ *
+ * The slack applies from the next time the work item is scheduled, until
+ * it is changed or the work item is initialized again.
+ *
+ * This requires @kconfig{CONFIG_WORK_DELAYABLE_SLACK}.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param slack the maximum additional delay, or @c K_NO_WAIT to submit the
+ * work item exactly after its delay. It must be a relative timeout.
+ */
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack);
+
+/** @brief Statistics of delayable work timeouts. */
+struct k_work_delayable_stats {
+	/** Number of delays that ended, submitting their work item. */
+	uint32_t expired;
+	/** Number of those that shared the timer wakeup of another one
+	 * because slack moved them, or the other one, onto the same tick.
+	 * Delays that ended on a shared tick anyway are not counted.
+	 */
+	uint32_t coalesced;
+	/** Number of delays whose end the slack of their work item moved. */
+	uint32_t slacked;
+};
+
+/** @brief Get the statistics of delayable work timeouts.
+ *
+ * This requires @kconfig{CONFIG_WORK_DELAYABLE_SLACK}.
+ *
+ * @param stats pointer to the statistics to fill.
+ */
+void k_work_delayable_stats_get(struct k_work_delayable_stats *stats);
+
+/** @brief Reset the statistics of delayable work timeouts.
+ *
+ * This requires @kconfig{CONFIG_WORK_DELAYABLE_SLACK}.
+ */
+void k_work_delayable_stats_reset(void);
+
 /** @brief Submit an idle work item to a queue after a delay.
  *
  * Unlike k_work_reschedule_for_queue() this is a no-op if the work item is
@@ -3897,6 +3944,14 @@ struct k_work_delayable {
 
 	/* The queue to which the work should be submitted. */
 	struct k_work_q *queue;
+
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	/* Ticks by which the timeout may be delayed to batch expirations. */
+	uint32_t slack;
+
+	/* Whether the slack moved the current timeout. */
+	bool slacked;
+#endif
 };
 
 #define Z_WORK_DELAYABLE_INITIALIZER(work_handler) { \
@@ -4420,6 +4475,10 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+	/** Reserved message, if any */
+	char *reserve_ptr;
+	/** Number of messages held back by the reservation, including it */
+	uint32_t reserved_msgs;
 
 	Z_DECL_POLL_EVENT
 
@@ -4542,7 +4601,8 @@ __syscall int k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
  * @param msgq message queue to cleanup
  *
  * @retval 0 on success
- * @retval -EBUSY Queue not empty
+ * @retval -EBUSY Queue not empty, or a message is reserved with
+ *	k_msgq_put_reserve() and not committed yet
  */
 int k_msgq_cleanup(struct k_msgq *msgq);
 
@@ -4591,6 +4651,102 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs messages, stored back to back at
+ * @a data, to message queue @a msgq under a single lock of the queue. It
+ * sends as many messages as there is room for without waiting. Only when
+ * the queue is full does it wait, up to @a timeout, for room for the first
+ * message.
+ *
+ * @note The messages are copied from @a data, which is not retained.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Non-negative waiting period to add a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, at least one, on success.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner, under a single lock of the
+ * queue, and stores them back to back at @a data. It receives the messages
+ * already queued without waiting. Only when the queue is empty does it
+ * wait, up to @a timeout, for one message.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, at least one, on success.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Reserve room for a message in a message queue.
+ *
+ * This routine reserves the next free message of the ring buffer of
+ * message queue @a msgq, so the caller can build the message in place
+ * instead of copying it with k_msgq_put(). The message is only received
+ * once k_msgq_put_commit() is called. Messages sent meanwhile are queued
+ * after the reserved one and are also held back until then, and senders
+ * finding the queue full return -ENOMSG without waiting.
+ *
+ * A message queue has at most one reservation at a time. The ring buffer
+ * is not accessible from user mode, so this routine is only available to
+ * supervisor threads and ISRs.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Address of the pointer set to the reserved message.
+ *
+ * @retval 0 Message reserved.
+ * @retval -ENOMSG Message queue is full.
+ * @retval -EBUSY Message queue already has a reservation.
+ */
+int k_msgq_put_reserve(struct k_msgq *msgq, void **msg);
+
+/**
+ * @brief Send a reserved message.
+ *
+ * This routine sends the message reserved with k_msgq_put_reserve(),
+ * along with the messages sent to @a msgq since then.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL Message queue has no reservation.
+ */
+int k_msgq_put_commit(struct k_msgq *msgq);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4662,7 +4818,7 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - msgq->used_msgs - msgq->reserved_msgs;
 }
 
 /**
@@ -5062,6 +5218,15 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Free blocks of a memory slab kept by one CPU */
+struct z_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5074,8 +5239,21 @@ struct k_mem_slab {
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_t waiters;
+	/* Blocks allocated and not freed, info.num_used counts the cached
+	 * ones too
+	 */
+	atomic_t in_use;
+	struct z_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+#endif
+
 #define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
 			       _slab_num_blocks)                      \
 	{                                                             \
@@ -5222,7 +5400,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5257,7 +5439,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5294,12 +5476,29 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
  * @{
  */
 
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+/* Small blocks of a k_heap kept by one CPU, one stack per size class */
+struct z_heap_cpu_cache {
+	struct k_spinlock lock;
+	uint8_t count[CONFIG_K_HEAP_CPU_CACHE_CLASSES];
+	void *blocks[CONFIG_K_HEAP_CPU_CACHE_CLASSES][CONFIG_K_HEAP_CPU_CACHE_DEPTH];
+};
+#endif
+
+/** @endcond */
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	atomic_t waiters;
+	struct z_heap_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
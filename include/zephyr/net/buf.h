@@ -968,6 +968,53 @@ struct net_buf_data_alloc {
 	size_t max_alloc_size;
 };
 
+/**
+ * @brief Network buffer pool statistics.
+ *
+ * Collected when CONFIG_NET_BUF_POOL_STATS is enabled, see
+ * net_buf_pool_stats_get().
+ */
+struct net_buf_pool_stats {
+	/** Number of successful allocations */
+	uint32_t allocs;
+
+	/** Number of allocations which failed or timed out */
+	uint32_t failures;
+
+	/** Number of allocations served from a per-CPU cache */
+	uint32_t cache_hits;
+
+	/** Lowest number of free buffers seen after an allocation */
+	uint32_t min_avail;
+
+	/** Longest time spent in one allocation, in cycles */
+	uint32_t max_alloc_cycles;
+
+	/** Total time spent in allocations, in cycles */
+	uint64_t alloc_cycles;
+};
+
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE) || defined(CONFIG_NET_BUF_POOL_STATS)
+/* Per-CPU state of a pool, only contended when an allocation reclaims the
+ * buffers cached by the other CPUs.
+ */
+struct net_buf_pool_cpu {
+	struct k_spinlock lock;
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	/* Free buffers, the most recently freed one last */
+	struct net_buf *cache[CONFIG_NET_BUF_POOL_CPU_CACHE_SIZE];
+	uint8_t cache_count;
+#endif
+
+#if defined(CONFIG_NET_BUF_POOL_STATS)
+	struct net_buf_pool_stats stats;
+#endif
+};
+#endif
+/** @endcond */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1000,6 +1047,21 @@ struct net_buf_pool {
 	const char *name;
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	/** Number of threads waiting for the free LIFO */
+	atomic_t waiters;
+#endif
+
+#if defined(CONFIG_NET_BUF_POOL_STATS)
+	/** Lowest amount of available buffers in the pool. */
+	atomic_t min_avail;
+#endif
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE) || defined(CONFIG_NET_BUF_POOL_STATS)
+	/** Per-CPU buffer caches and statistics */
+	struct net_buf_pool_cpu cpu[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -1013,7 +1075,8 @@ struct net_buf_pool {
 /** @cond INTERNAL_HIDDEN */
 #define NET_BUF_POOL_USAGE_INIT(_pool, _count) \
 	IF_ENABLED(CONFIG_NET_BUF_POOL_USAGE, (.avail_count = ATOMIC_INIT(_count),)) \
-	IF_ENABLED(CONFIG_NET_BUF_POOL_USAGE, (.name = STRINGIFY(_pool),))
+	IF_ENABLED(CONFIG_NET_BUF_POOL_USAGE, (.name = STRINGIFY(_pool),)) \
+	IF_ENABLED(CONFIG_NET_BUF_POOL_STATS, (.min_avail = ATOMIC_INIT(_count),))
 
 #define NET_BUF_POOL_INITIALIZER(_pool, _alloc, _bufs, _count, _ud_size, _destroy) \
 	{                                                                          \
@@ -1204,6 +1267,30 @@ extern const struct net_buf_data_cb net_buf_var_cb;
  */
 struct net_buf_pool *net_buf_pool_get(int id);
 
+#if defined(CONFIG_NET_BUF_POOL_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the allocation statistics of a pool.
+ *
+ * Requires CONFIG_NET_BUF_POOL_STATS. The counters of all the CPUs are
+ * summed up.
+ *
+ * @param pool Buffer pool.
+ * @param stats Filled with the statistics of the pool.
+ */
+void net_buf_pool_stats_get(struct net_buf_pool *pool,
+			    struct net_buf_pool_stats *stats);
+
+/**
+ * @brief Reset the allocation statistics of a pool.
+ *
+ * Requires CONFIG_NET_BUF_POOL_STATS. The lowest number of free buffers
+ * restarts from the current number of free buffers.
+ *
+ * @param pool Buffer pool.
+ */
+void net_buf_pool_stats_reset(struct net_buf_pool *pool);
+#endif
+
 /**
  * @brief Get a zero-based index for a buffer.
  *
@@ -1339,6 +1426,10 @@ struct net_buf * __must_check net_buf_get(struct k_fifo *fifo,
 					  k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1359,7 +1450,11 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	net_buf_pool_cache_put(pool, buf);
+#else
 	k_lifo_put(&pool->free, buf);
+#endif
 }
 
 /**
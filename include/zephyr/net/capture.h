@@ -166,6 +166,126 @@ static inline int net_capture_disable(const struct device *dev)
 #endif
 }
 
+/** Capture ring statistics */
+struct net_capture_ring_stats {
+	/** Packets stored in the ring since it was started */
+	uint32_t captured;
+	/** Packets rejected by the filter */
+	uint32_t filtered;
+	/** Packets overwritten by newer ones before being exported */
+	uint32_t overwritten;
+	/** Packets not stored because an export was in progress */
+	uint32_t dropped;
+	/** Bytes of packet records currently held in the ring */
+	uint32_t used;
+	/** Size of the ring in bytes */
+	uint32_t size;
+};
+
+/**
+ * @typedef net_capture_ring_export_cb_t
+ * @brief Callback receiving the pcapng data of an exported capture ring
+ *
+ * @param data Next chunk of the pcapng stream. The capture ring memory is
+ *        passed as is, so the data is only valid during the call.
+ * @param len Length of the chunk in bytes
+ * @param user_data User supplied data
+ *
+ * @return 0 to continue the export, <0 to abort it
+ */
+typedef int (*net_capture_ring_export_cb_t)(const void *data, size_t len, void *user_data);
+
+struct npf_rule_list;
+
+/**
+ * @brief Start recording packets in the in-RAM capture ring.
+ *
+ * @details The content of the ring and its statistics are cleared. Every
+ *          packet passing the capture hook, on any network interface, is
+ *          then evaluated against @p filter and, if accepted, a snapshot of
+ *          at most CONFIG_NET_CAPTURE_RING_SNAPLEN bytes is stored in the
+ *          ring. The oldest packets are overwritten when the ring is full.
+ *
+ * @param filter Packet filter rule list selecting the packets to record,
+ *        see net_pkt_filter_rules_ok(). NULL records every packet. The rule
+ *        list must stay valid until the ring is stopped.
+ *
+ * @return 0 if ok, -ENOTSUP if a filter is given without
+ *         CONFIG_NET_PKT_FILTER, -EBUSY if an export is in progress
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_start(struct npf_rule_list *filter);
+#else
+static inline int net_capture_ring_start(struct npf_rule_list *filter)
+{
+	ARG_UNUSED(filter);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Stop recording packets in the in-RAM capture ring.
+ *
+ * @details The recorded packets are kept until the ring is started again.
+ *
+ * @return 0 if ok, -EALREADY if the ring was not started
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_stop(void);
+#else
+static inline int net_capture_ring_stop(void)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Export the content of the in-RAM capture ring as a pcapng stream.
+ *
+ * @details The callback first receives a Section Header Block and one
+ *          Interface Description Block per network interface, in interface
+ *          index order, followed by the recorded Enhanced Packet Blocks,
+ *          oldest first. Packet timestamps are in microseconds since boot.
+ *          Packets arriving while the export runs are not recorded. The
+ *          ring content is left untouched.
+ *
+ * @param cb Callback receiving the data
+ * @param user_data User supplied data
+ *
+ * @return Number of bytes exported, or <0 on error or if the callback
+ *         aborted the export
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_export(net_capture_ring_export_cb_t cb, void *user_data);
+#else
+static inline int net_capture_ring_export(net_capture_ring_export_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the statistics of the in-RAM capture ring.
+ *
+ * @param stats Statistics are returned here
+ *
+ * @return 0 if ok, <0 on error
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_stats_get(struct net_capture_ring_stats *stats);
+#else
+static inline int net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 /**
@@ -211,6 +331,16 @@ static inline void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 }
 #endif
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+}
+#endif
+
 struct net_capture_info {
 	const struct device *capture_dev;
 	struct net_if *capture_iface;
@@ -282,6 +282,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	/** Entries of epoll interest lists monitoring this socket */
+	sys_slist_t epoll_items;
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1182,6 +1187,34 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a datagram made of a network buffer chain without copying it.
+ *
+ * @details The buffer chain is linked after the protocol headers of the
+ * packet to send instead of being copied to it. A reference to the chain
+ * is taken for as long as the packet exists, so the data must not be
+ * modified until the buffers are released. Only UDP contexts are
+ * supported. If dst_addr is NULL, the packet is sent to the address the
+ * context is connected to.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer chain to send, the caller keeps its reference.
+ * @param dst_addr Destination address, or NULL.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *buf,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
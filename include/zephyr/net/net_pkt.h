@@ -272,6 +272,20 @@ struct net_pkt {
 	uint16_t vlan_tci;
 #endif /* CONFIG_NET_VLAN */
 
+#if defined(CONFIG_NET_GSO)
+	/* Size of the TCP segments this packet is split into before it is
+	 * given to the network device, 0 if the packet is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_GSO */
+
+#if defined(CONFIG_NET_RPS)
+	/* Flow hash of a received packet selecting its RX queue, 0 if not
+	 * known yet.
+	 */
+	uint32_t rx_hash;
+#endif /* CONFIG_NET_RPS */
+
 #if defined(NET_PKT_HAS_CONTROL_BLOCK)
 	/* TODO: Evolve this into a union of orthogonal
 	 *       control block declarations if further L2
@@ -469,6 +483,63 @@ static inline void net_pkt_set_ip_ecn(struct net_pkt *pkt, uint8_t ecn)
 #endif
 }
 
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_GSO)
+	return pkt->gso_size;
+#else
+	return 0;
+#endif
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+#if defined(CONFIG_NET_GSO)
+	pkt->gso_size = gso_size;
+#endif
+}
+
+/**
+ * @brief Get the flow hash of a received packet.
+ *
+ * @param pkt Network packet.
+ *
+ * @return Flow hash set by the driver or calculated by the stack, 0 if
+ *         there is none.
+ */
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_RPS)
+	return pkt->rx_hash;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+/**
+ * @brief Set the flow hash of a received packet.
+ *
+ * Drivers of devices that calculate a flow hash (receive side scaling) can
+ * set it before calling net_recv_data(), and drivers of devices receiving
+ * on several hardware queues can set the queue number plus one. All the
+ * packets with the same hash are processed by the same RX queue. The stack
+ * hashes the addresses and ports of the packets for which this is 0.
+ *
+ * @param pkt Network packet.
+ * @param hash Flow hash.
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+#if defined(CONFIG_NET_RPS)
+	pkt->rx_hash = hash;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+#endif
+}
+
 static inline uint8_t net_pkt_tcp_1st_msg(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_TCP)
@@ -107,6 +107,19 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule);
  */
 bool npf_remove_all_rules(struct npf_rule_list *rules);
 
+/**
+ * @brief Evaluate a rule list against a packet
+ *
+ * This is the same evaluation done at the stack's own test points, and
+ * it lets other subsystems use a private rule list as a packet selector.
+ * An empty rule list accepts every packet.
+ *
+ * @param rules the rule list to evaluate
+ * @param pkt the packet to test
+ * @retval true if the first matching rule accepts the packet
+ */
+bool net_pkt_filter_rules_ok(struct npf_rule_list *rules, struct net_pkt *pkt);
+
 /* convenience shortcuts */
 #define npf_insert_send_rule(rule) npf_insert_rule(&npf_send_rules, rule)
 #define npf_insert_recv_rule(rule) npf_insert_rule(&npf_recv_rules, rule)
@@ -27,9 +27,11 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/socket_select.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <stdlib.h>
+#include <errno.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -82,6 +84,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block for the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -529,6 +533,108 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send several messages with one call
+ *
+ * @details
+ * Sends the messages of @p msgvec in order as with zsock_sendmsg(), looking
+ * up the socket and taking its lock only once. The number of bytes sent for
+ * each message is stored in its @c msg_len. The call stops at the first
+ * message that cannot be sent.
+ *
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor.
+ * @param msgvec Messages to send.
+ * @param vlen Number of messages in @p msgvec.
+ * @param flags Flags as for zsock_sendmsg(), applied to every message.
+ *
+ * @return Number of messages sent, or -1 with errno set if the first one
+ *         could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages with one call
+ *
+ * @details
+ * Receives up to @p vlen messages in order as with zsock_recvmsg(), looking
+ * up the socket and taking its lock only once. The number of bytes received
+ * for each message is stored in its @c msg_len. Unless the socket is non
+ * blocking, the call waits for every message, or only for the first one
+ * with ``ZSOCK_MSG_WAITFORONE``. It returns early when a receive fails
+ * after at least one message was received.
+ *
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor.
+ * @param msgvec Messages to receive.
+ * @param vlen Number of messages in @p msgvec.
+ * @param flags Flags as for zsock_recvmsg(), and ``ZSOCK_MSG_WAITFORONE``.
+ *
+ * @return Number of messages received, or -1 with errno set if none could
+ *         be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY) || defined(__DOXYGEN__)
+struct net_buf;
+
+/**
+ * @brief Receive data as a network buffer chain without copying it
+ *
+ * @details
+ * The unread payload of the next received packet is handed over as a chain
+ * of network buffers, which the caller must release with net_buf_unref()
+ * once done with it. For a datagram socket this is the whole datagram, for
+ * a stream socket this is the next segment of the stream. The buffers come
+ * from the network receive pools, so they should not be held for long.
+ * This is a kernel mode only extension, available for native network stack
+ * sockets when :kconfig:option:`CONFIG_NET_SOCKETS_ZERO_COPY` is enabled.
+ * ``ZSOCK_MSG_PEEK`` is not supported.
+ *
+ * @param sock Socket to receive from
+ * @param buf Filled with the received buffer chain, or NULL if none
+ * @param flags ``ZSOCK_MSG_DONTWAIT`` or 0
+ * @param src_addr Filled with the source address of a datagram, or NULL
+ * @param addrlen Value-result length of @p src_addr, or NULL
+ *
+ * @return Number of bytes received, 0 at the end of a stream, or -1 with
+ *         errno set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Send a datagram made of a network buffer chain without copying it
+ *
+ * @details
+ * The buffer chain is linked to the packet after its protocol headers
+ * instead of being copied. The caller keeps its reference to the chain and
+ * the stack takes its own until the packet is sent, so the data must not be
+ * modified until the buffers are released, which the destroy callback of
+ * their pool reports. Buffers wrapping application memory can be made with
+ * net_buf_alloc_with_data(). Only datagram sockets are supported, as stream
+ * sockets always copy data to their retransmission queue.
+ * This is a kernel mode only extension, available for native network stack
+ * sockets when :kconfig:option:`CONFIG_NET_SOCKETS_ZERO_COPY` is enabled.
+ *
+ * @param sock Socket to send to
+ * @param buf Buffer chain to send
+ * @param flags ``ZSOCK_MSG_DONTWAIT`` or 0
+ * @param dest_addr Destination address, or NULL for a connected socket
+ * @param addrlen Length of @p dest_addr
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen);
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY */
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -937,6 +1043,13 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -950,6 +1063,20 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+struct timespec;
+
+/** POSIX wrapper for @ref zsock_recvmmsg, only a NULL timeout is supported */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags, struct timespec *timeout)
+{
+	if (timeout != NULL) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1056,6 +1183,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1192,9 +1321,27 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, as a string (e.g. "reno" or "cubic") */
+#define TCP_CONGESTION 5
+/** Connection information (struct tcp_info), read-only */
+#define TCP_INFO 6
 
 /** @} */
 
+/** Connection information returned by the TCP_INFO socket option */
+struct tcp_info {
+	uint32_t tcpi_rto;           /**< Retransmission timeout (usec) */
+	uint32_t tcpi_snd_mss;       /**< Sending maximum segment size */
+	uint32_t tcpi_unacked;       /**< Segments sent but not yet acknowledged */
+	uint32_t tcpi_rtt;           /**< Smoothed round trip time (usec) */
+	uint32_t tcpi_rttvar;        /**< Round trip time variation (usec) */
+	uint32_t tcpi_snd_ssthresh;  /**< Slow start threshold (segments) */
+	uint32_t tcpi_snd_cwnd;      /**< Congestion window (segments) */
+	uint32_t tcpi_snd_wnd;       /**< Peer's receive window (bytes) */
+	uint32_t tcpi_rcv_wnd;       /**< Own receive window (bytes) */
+	uint32_t tcpi_total_retrans; /**< Retransmitted segments */
+};
+
 /**
  * @name IPv4 level options (IPPROTO_IP)
  * @{
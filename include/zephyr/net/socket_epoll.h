@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Socket is readable, or a connection is waiting to be accepted */
+#define ZSOCK_EPOLLIN BIT(0)
+/** Socket is writable */
+#define ZSOCK_EPOLLOUT BIT(2)
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR BIT(3)
+/** Peer closed the connection, always reported */
+#define ZSOCK_EPOLLHUP BIT(4)
+/** Disable the entry after one event until it is rearmed with
+ * ZSOCK_EPOLL_CTL_MOD
+ */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+
+/** Add a socket to the interest list */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a socket from the interest list */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events or the user data of a socket in the interest list */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data associated with an entry of the interest list */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Events of interest, or events that occurred, and their user data */
+struct zsock_epoll_event {
+	uint32_t events;          /**< ZSOCK_EPOLL* event mask */
+	zsock_epoll_data_t data;  /**< User data, returned as is */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * An epoll instance keeps a persistent interest list of sockets. The network
+ * stack moves a socket to the ready list of the instance as soon as it
+ * becomes readable or changes state, so unlike zsock_poll() the cost of
+ * zsock_epoll_wait() depends on the number of ready sockets only. Only
+ * native network stack sockets can be added to the interest list, and only
+ * level-triggered notification is supported. The instance is released with
+ * zsock_close().
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param flags Must be 0.
+ *
+ * @return File descriptor of the instance, or -1 and errno set on error.
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove an entry of an epoll interest list
+ *
+ * @details
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd File descriptor of the epoll instance.
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL.
+ * @param fd Socket the operation applies to.
+ * @param event Events of interest and user data, ignored for
+ *        ZSOCK_EPOLL_CTL_DEL.
+ *
+ * @return 0 on success, or -1 and errno set on error.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on the sockets of an epoll interest list
+ *
+ * @details
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd File descriptor of the epoll instance.
+ * @param events Array receiving the ready sockets.
+ * @param maxevents Size of @p events, must be greater than 0.
+ * @param timeout Timeout in milliseconds, -1 to wait forever.
+ *
+ * @return Number of entries stored in @p events, 0 on timeout, or -1 and
+ *         errno set on error.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
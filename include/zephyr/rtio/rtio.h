@@ -130,8 +130,10 @@ extern "C" {
 /**
  * @brief The SQE should continue producing CQEs until canceled
  *
- * This flag must exist along @ref RTIO_SQE_MEMPOOL_BUFFER and signals that when a read is
- * complete. It should be placed back in queue until canceled.
+ * Signals that when the operation is complete it should be placed back in queue until
+ * canceled, producing one CQE per completion. Any operation handled by an iodev may be
+ * multishot. Reads must also set @ref RTIO_SQE_MEMPOOL_BUFFER so that each completion
+ * gets its own buffer, other operations reuse the same buffers on every completion.
  */
 #define RTIO_SQE_MULTISHOT BIT(4)
 
@@ -342,6 +344,21 @@ struct rtio {
 	struct k_sem *consume_sem;
 #endif
 
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	/* A wait semaphore given once when the number of available
+	 * completions reaches the count a thread is waiting for
+	 */
+	struct k_sem *cqe_wait_sem;
+
+	/* Number of completions in the queue not yet consumed, counted
+	 * after they are queued so it may briefly be negative
+	 */
+	atomic_t cqe_avail;
+
+	/* Number of completions the waiting thread needs, 0 if none */
+	atomic_t cqe_wait;
+#endif
+
 	/* Total number of completions */
 	atomic_t cq_count;
 
@@ -525,6 +542,11 @@ static inline void rtio_sqe_prep_read_with_pool(struct rtio_sqe *sqe,
 	sqe->flags = RTIO_SQE_MEMPOOL_BUFFER;
 }
 
+/**
+ * @brief Prepare a multishot read op submission with context's mempool
+ *
+ * @see rtio_sqe_prep_read_with_pool()
+ */
 static inline void rtio_sqe_prep_read_multishot(struct rtio_sqe *sqe,
 						const struct rtio_iodev *iodev, int8_t prio,
 						void *userdata)
@@ -552,6 +574,25 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a multishot write op submission
+ *
+ * The same buffer is written again each time the previous write completes until
+ * the submission is canceled.
+ *
+ * @see rtio_sqe_prep_write()
+ */
+static inline void rtio_sqe_prep_write_multishot(struct rtio_sqe *sqe,
+						 const struct rtio_iodev *iodev,
+						 int8_t prio,
+						 uint8_t *buf,
+						 uint32_t len,
+						 void *userdata)
+{
+	rtio_sqe_prep_write(sqe, iodev, prio, buf, len, userdata);
+	sqe->flags |= RTIO_SQE_MULTISHOT;
+}
+
 /**
  * @brief Prepare a tiny write op submission
  *
@@ -623,6 +664,27 @@ static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a multishot transceive op submission
+ *
+ * The transfer is started again each time the previous one completes until the
+ * submission is canceled. The receive buffer is overwritten by every transfer, so
+ * each completion should be consumed before the next one is produced.
+ *
+ * @see rtio_sqe_prep_transceive()
+ */
+static inline void rtio_sqe_prep_transceive_multishot(struct rtio_sqe *sqe,
+						      const struct rtio_iodev *iodev,
+						      int8_t prio,
+						      uint8_t *tx_buf,
+						      uint8_t *rx_buf,
+						      uint32_t buf_len,
+						      void *userdata)
+{
+	rtio_sqe_prep_transceive(sqe, iodev, prio, tx_buf, rx_buf, buf_len, userdata);
+	sqe->flags |= RTIO_SQE_MULTISHOT;
+}
+
 static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *pool)
 {
 	struct rtio_mpsc_node *node = rtio_mpsc_pop(&pool->free_q);
@@ -788,10 +850,15 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 		   (static K_SEM_DEFINE(_submit_sem_##name, 0, K_SEM_MAX_LIMIT)))                  \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
 		   (static K_SEM_DEFINE(_consume_sem_##name, 0, K_SEM_MAX_LIMIT)))                 \
+	IF_ENABLED(CONFIG_RTIO_CQE_WAIT_SEM,                                                       \
+		   (static K_SEM_DEFINE(_cqe_wait_sem_##name, 0, 1)))                              \
 	STRUCT_SECTION_ITERABLE(rtio, name) = {                                                    \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_sem = &_submit_sem_##name,))           \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_count = 0,))                           \
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &_consume_sem_##name,))        \
+		IF_ENABLED(CONFIG_RTIO_CQE_WAIT_SEM, (.cqe_wait_sem = &_cqe_wait_sem_##name,))     \
+		IF_ENABLED(CONFIG_RTIO_CQE_WAIT_SEM, (.cqe_avail = ATOMIC_INIT(0),))               \
+		IF_ENABLED(CONFIG_RTIO_CQE_WAIT_SEM, (.cqe_wait = ATOMIC_INIT(0),))                \
 		.cq_count = ATOMIC_INIT(0),                                                        \
 		.xcqcnt = ATOMIC_INIT(0),                                                          \
 		.sqe_pool = _sqe_pool,                                                             \
@@ -983,6 +1050,10 @@ static inline struct rtio_cqe *rtio_cqe_consume(struct rtio *r)
 	}
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
 
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	atomic_dec(&r->cqe_avail);
+#endif
+
 	return cqe;
 }
 
@@ -1011,9 +1082,93 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 	}
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
 
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	atomic_dec(&r->cqe_avail);
+#endif
+
 	return cqe;
 }
 
+/**
+ * @brief Consume up to a number of completion queue events if available
+ *
+ * Each returned completion queue event must be released with rtio_cqe_release()
+ * at some point, in any order.
+ *
+ * @param r RTIO context
+ * @param cqes Array to fill with the consumed completion queue events
+ * @param max Maximum number of completion queue events to consume
+ *
+ * @return Number of completion queue events consumed, possibly 0
+ */
+static inline size_t rtio_cqe_consume_batch(struct rtio *r, struct rtio_cqe **cqes, size_t max)
+{
+	size_t count = 0;
+
+	while (count < max) {
+		struct rtio_cqe *cqe = rtio_cqe_consume(r);
+
+		if (cqe == NULL) {
+			break;
+		}
+		cqes[count++] = cqe;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+/**
+ * @brief Wait for a number of completion queue events to be available
+ *
+ * The calling thread is woken up once when at least @p count completion queue
+ * events are available to consume or when the timeout expires, whichever comes
+ * first. Only one thread may wait on a given RTIO context at a time. The
+ * completions can then be consumed with rtio_cqe_consume_batch().
+ *
+ * Requires @kconfig{CONFIG_RTIO_CQE_WAIT_SEM}.
+ *
+ * @param r RTIO context
+ * @param count Number of completion queue events to wait for
+ * @param timeout Maximum time to wait for them
+ *
+ * @retval 0 At least @p count completion queue events are available
+ * @retval -EBUSY Returned without waiting
+ * @retval -EAGAIN Waiting period timed out
+ */
+static inline int rtio_cqe_wait(struct rtio *r, uint32_t count, k_timeout_t timeout)
+{
+	bool waited = false;
+	int res = 0;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	atomic_set(&r->cqe_wait, count);
+
+	/* Signed, as a consumer may pop a completion before its producer
+	 * counts it, taking the count below zero for a moment.
+	 */
+	if (atomic_get(&r->cqe_avail) < (atomic_val_t)count) {
+		res = k_sem_take(r->cqe_wait_sem, timeout);
+		waited = (res == 0);
+	}
+
+	if (!atomic_cas(&r->cqe_wait, count, 0)) {
+		/* A producer met the count and gave the semaphore, take it
+		 * back if that did not already wake us up.
+		 */
+		if (!waited) {
+			(void)k_sem_take(r->cqe_wait_sem, K_FOREVER);
+		}
+		res = 0;
+	}
+
+	return res;
+}
+#endif
+
 /**
  * @brief Release consumed completion queue event
  *
@@ -1181,6 +1336,17 @@ static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata, u
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_sem_give(r->consume_sem);
 #endif
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	/* Last so that the woken up thread can consume the whole batch */
+	if (cqe != NULL) {
+		atomic_val_t avail = atomic_inc(&r->cqe_avail) + 1;
+		atomic_val_t wait = atomic_get(&r->cqe_wait);
+
+		if (wait > 0 && avail >= wait && atomic_cas(&r->cqe_wait, wait, 0)) {
+			k_sem_give(r->cqe_wait_sem);
+		}
+	}
+#endif
 }
 
 #define __RTIO_MEMPOOL_GET_NUM_BLKS(num_bytes, blk_size) (((num_bytes) + (blk_size)-1) / (blk_size))
@@ -1282,6 +1448,10 @@ static inline void rtio_access_grant(struct rtio *r, struct k_thread *t)
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_object_access_grant(r->consume_sem, t);
 #endif
+
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	k_object_access_grant(r->cqe_wait_sem, t);
+#endif
 }
 
 /**
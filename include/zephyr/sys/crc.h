@@ -252,6 +252,33 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len);
 uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		 size_t len, bool first_pkt, bool last_pkt);
 
+/**
+ * @brief CRC32 backend
+ *
+ * Functions updating a raw CRC32 register over a buffer, without the
+ * initial value nor the final XOR, for instance using a CRC peripheral.
+ * A NULL member keeps the built-in implementation for that polynomial.
+ */
+struct crc32_backend {
+	/** Update a reflected CRC32 (IEEE 802.3, 0xEDB88320) register */
+	uint32_t (*ieee_update)(uint32_t crc, const uint8_t *data, size_t len);
+	/** Update a reflected CRC32C (Castagnoli, 0x82F63B78) register */
+	uint32_t (*c_update)(uint32_t crc, const uint8_t *data, size_t len);
+};
+
+/**
+ * @brief Register a CRC32 backend
+ *
+ * Overrides the built-in implementation of crc32_ieee(),
+ * crc32_ieee_update() and crc32_c() with the functions of @p backend.
+ * Meant to be called by a driver during its initialization, before the
+ * CRC32 functions are used.
+ *
+ * @param backend Backend to use, or NULL to restore the built-in
+ *                implementations.
+ */
+void crc32_backend_register(const struct crc32_backend *backend);
+
 /**
  * @brief Compute CCITT variant of CRC 8
  *
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_WS_POOL_H_
+#define ZEPHYR_INCLUDE_SYS_WS_POOL_H_
+
+#include <zephyr/kernel.h>
+
+/* Zephyr Work-Stealing Thread Pool
+ *
+ * A fixed set of worker threads, ideally one per CPU, each with its own
+ * deque of jobs. Workers run the jobs of their own deque newest first and,
+ * once it is empty, steal the oldest jobs of the other workers. Jobs
+ * submitted from a job go to the deque of the worker running it, so the
+ * workers only contend when one of them runs out of work.
+ */
+
+struct k_ws_job;
+
+/**
+ * Work-stealing pool job handler
+ */
+typedef void (*k_ws_handler_t)(struct k_ws_job *job);
+
+/**
+ * @brief Work-stealing pool job
+ *
+ * User-populated struct representing a single job. It must not be
+ * modified nor released from submission until the group it was submitted
+ * with has been waited for, or until the handler is called for jobs
+ * submitted without a group.
+ */
+struct k_ws_job {
+	/* Filled out by submitting code */
+	k_ws_handler_t handler;
+
+	/* reserved for implementation */
+	struct k_ws_group *group;
+};
+
+/**
+ * @brief Work-stealing pool job group
+ *
+ * Counts the jobs submitted with it that have not completed yet, so that
+ * they can be waited for all at once.
+ */
+struct k_ws_group {
+	atomic_t pending;
+	struct k_sem done;
+};
+
+/* Worker thread and its deque, reserved for implementation */
+struct z_ws_worker {
+	struct k_spinlock lock;
+	/* Free running indexes, the deque holds jobs [head, tail) */
+	uint32_t head;
+	uint32_t tail;
+	struct k_ws_job *jobs[CONFIG_WS_POOL_DEQUE_SIZE];
+	uint32_t executed;
+	uint32_t stolen;
+	struct k_thread thread;
+};
+
+/**
+ * @brief Work-stealing thread pool
+ */
+struct k_ws_pool {
+	struct z_ws_worker *workers;
+	uint32_t num_workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+
+	/* Number of workers out of jobs, and the semaphore they wait on */
+	atomic_t idle;
+	struct k_sem wake;
+
+	/* Next worker to get a job submitted from outside the pool */
+	atomic_t next;
+};
+
+/**
+ * @brief Work-stealing pool statistics
+ */
+struct k_ws_pool_stats {
+	/** Number of jobs run by the workers */
+	uint32_t executed;
+	/** Number of jobs a worker took from the deque of another one */
+	uint32_t stolen;
+};
+
+/**
+ * @brief Statically define a work-stealing thread pool
+ *
+ * Defines a struct k_ws_pool object with the specified number of worker
+ * threads, which are started by k_ws_pool_start().
+ *
+ * @param name Symbol name of the struct k_ws_pool that will be defined
+ * @param n_workers Number of worker threads in the pool
+ * @param stack_sz Requested stack size of each worker thread, in bytes
+ */
+#define K_WS_POOL_DEFINE(name, n_workers, stack_sz)			\
+	static K_THREAD_STACK_ARRAY_DEFINE(_ws_stacks_##name,		\
+					   n_workers, stack_sz);	\
+	static struct z_ws_worker _ws_workers_##name[n_workers];	\
+	struct k_ws_pool name = {					\
+		.workers = _ws_workers_##name,				\
+		.num_workers = n_workers,				\
+		.stacks = &(_ws_stacks_##name[0][0]),			\
+		.stack_size = stack_sz,					\
+	}
+
+/**
+ * @brief Start a work-stealing thread pool
+ *
+ * Starts the worker threads of a pool defined with K_WS_POOL_DEFINE().
+ * When CPU masks are supported, worker @a i is pinned to CPU
+ * @a i modulo the number of CPUs. Workers are named ws_pool followed by
+ * their index.
+ *
+ * @param pool Pool to start
+ * @param prio Priority of the worker threads
+ */
+void k_ws_pool_start(struct k_ws_pool *pool, int prio);
+
+/**
+ * @brief Initialize a job group
+ *
+ * @param group Job group to initialize
+ */
+void k_ws_group_init(struct k_ws_group *group);
+
+/**
+ * @brief Submit a job to a work-stealing thread pool
+ *
+ * Queues the job on the deque of the current worker when called from a
+ * job, or on the deque of the next worker in turn otherwise. If that deque
+ * is full, the job is run by the caller before returning.
+ *
+ * @param pool Pool to which to submit
+ * @param group Group to add the job to, or NULL
+ * @param job Job to submit, with its handler set
+ */
+void k_ws_pool_submit(struct k_ws_pool *pool, struct k_ws_group *group,
+		      struct k_ws_job *job);
+
+/**
+ * @brief Wait for the jobs of a group
+ *
+ * Returns once all the jobs submitted with @a group have completed. When
+ * called from a job, the current worker first runs the jobs it can find,
+ * its own ones included, so jobs can wait for the jobs they submitted. It
+ * then blocks until the jobs running on other workers complete. The group
+ * can then be reused.
+ *
+ * @param pool Pool to which the jobs were submitted
+ * @param group Group to wait for
+ */
+void k_ws_group_wait(struct k_ws_pool *pool, struct k_ws_group *group);
+
+/**
+ * Parallel for loop body, called for indexes [begin, end)
+ */
+typedef void (*k_ws_range_fn_t)(uint32_t begin, uint32_t end, void *arg);
+
+/**
+ * @brief Run a loop in parallel on a work-stealing thread pool
+ *
+ * Splits the indexes [begin, end) into at most
+ * CONFIG_WS_POOL_PARALLEL_FOR_JOBS ranges of at least @a grain indexes,
+ * and calls @a fn for each of them from the workers. The caller handles
+ * the first range itself and returns once all of them are done.
+ *
+ * @param pool Pool to run the loop on
+ * @param begin First index
+ * @param end Index after the last one
+ * @param grain Minimum number of indexes per call of @a fn
+ * @param fn Loop body
+ * @param arg Argument passed to @a fn
+ */
+void k_ws_parallel_for(struct k_ws_pool *pool, uint32_t begin, uint32_t end,
+		       uint32_t grain, k_ws_range_fn_t fn, void *arg);
+
+/**
+ * @brief Get the statistics of a work-stealing thread pool
+ *
+ * @param pool Pool to get the statistics of
+ * @param stats Address of the statistics to fill
+ */
+void k_ws_pool_stats_get(struct k_ws_pool *pool, struct k_ws_pool_stats *stats);
+
+#endif /* ZEPHYR_INCLUDE_SYS_WS_POOL_H_ */
@@ -15,6 +15,8 @@
 extern "C" {
 #endif
 
+struct net_buf;
+
 /**
  * @brief Zbus API
  * @defgroup zbus_apis Zbus APIs
@@ -56,6 +58,13 @@ struct zbus_channel_data {
 	 */
 	sys_slist_t observers;
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS */
+
+#if defined(CONFIG_ZBUS_MSG_ZERO_COPY) || defined(__DOXYGEN__)
+	/** Message being published by reference. Only set while the observers of a
+	 * zbus_chan_pub_buf() call are notified.
+	 */
+	struct net_buf *msg_buf;
+#endif /* CONFIG_ZBUS_MSG_ZERO_COPY */
 };
 
 /**
@@ -895,6 +904,89 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
+#if defined(CONFIG_ZBUS_MSG_ZERO_COPY) || defined(__DOXYGEN__)
+
+/**
+ * @brief Allocate a buffer for a zero-copy publication.
+ *
+ * This routine allocates a buffer from the message subscribers pool with room for one channel
+ * message. The message must be written directly into the buffer data and then handed to
+ * zbus_chan_pub_buf().
+ *
+ * @param chan The channel's reference.
+ * @param timeout Waiting period for a free buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return A buffer of the channel's message size, or NULL if none could be allocated.
+ */
+struct net_buf *zbus_chan_buf_alloc(const struct zbus_channel *chan, k_timeout_t timeout);
+
+/**
+ * @brief Publish a message by reference.
+ *
+ * This routine publishes the message held by @p buf without copying it. Message subscribers
+ * receive references to the same data, and listeners can reach it with zbus_chan_const_buf().
+ * The channel's message storage is not updated, so zbus_chan_read() does not see the message and
+ * subscribers, which would have to read it from there, are not notified. The caller's reference is
+ * consumed, even on failure.
+ *
+ * @param chan The channel's reference.
+ * @param buf Buffer obtained with zbus_chan_buf_alloc() holding the message.
+ * @param timeout Waiting period to publish the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -ENOMSG The message is invalid based on the validator function.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Timeout to take the lock on the channel.
+ * @retval -ENOMEM There is not more net_buf to clone the message for message subscribers.
+ * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
+ * observer, or the function context is invalid (inside an ISR). The function only returns this
+ * value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_pub_buf(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout);
+
+/**
+ * @brief Get the message being published by reference.
+ *
+ * This routine should be used inside listeners to access a message published with
+ * zbus_chan_pub_buf() without copying it.
+ *
+ * @param chan The channel's constant reference.
+ *
+ * @return The published buffer, or NULL if the notification is not a zbus_chan_pub_buf() one.
+ */
+static inline const struct net_buf *zbus_chan_const_buf(const struct zbus_channel *chan)
+{
+	__ASSERT(chan != NULL, "chan is required");
+
+	return chan->data->msg_buf;
+}
+
+/**
+ * @brief Wait for a channel message reference.
+ *
+ * This routine makes the message subscriber wait for the next message like
+ * zbus_sub_wait_msg(), but hands over the buffer holding it instead of copying the message
+ * out. The data must be treated as read-only since it may be shared with other observers.
+ * The caller must release the buffer with net_buf_unref().
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the published message.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+		      struct net_buf **buf, k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_ZERO_COPY */
+
 /**
  *
  * @brief Iterate over channels.
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_PERCPU_CACHE_H_
+#define ZEPHYR_KERNEL_INCLUDE_PERCPU_CACHE_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * Protocol shared by the allocators keeping per-CPU caches of free objects
+ * in front of a shared free list (net_buf pools, k_heap and k_mem_slab).
+ *
+ * Each allocator has an array of per-CPU caches with a spinlock named lock
+ * in each element, and counts the threads waiting on its shared free list.
+ * Lock order is the lock of a cache, then the lock of the free list.
+ *
+ * A thread about to wait for the free list announces itself, then flushes
+ * every cache to the free list. Frees check for waiters under the lock of
+ * their cache and bypass it when there are any, so either they see the
+ * waiter or the waiter's flush sees the object they cached. Caches are not
+ * refilled while there are waiters.
+ */
+
+/* Called with the lock of cache number cpu held, to give all the objects
+ * it holds back to the free list of obj.
+ */
+typedef void (*z_percpu_cache_flush_t)(void *obj, unsigned int cpu);
+
+static inline unsigned int z_percpu_cache_cpu_id(void)
+{
+#ifdef CONFIG_SMP
+	return arch_curr_cpu()->id;
+#else
+	return 0;
+#endif
+}
+
+static inline struct k_spinlock *z_percpu_cache_lock_get(struct k_spinlock *first,
+							 size_t stride,
+							 unsigned int cpu)
+{
+	return (struct k_spinlock *)((char *)first + cpu * stride);
+}
+
+/* Lock the cache of the CPU we run on and return its number. The thread
+ * may migrate until interrupts are locked, so check that it did not
+ * before using it.
+ */
+static inline unsigned int z_percpu_cache_lock(struct k_spinlock *first,
+					       size_t stride,
+					       k_spinlock_key_t *key)
+{
+	struct k_spinlock *lock;
+	unsigned int cpu;
+
+	while (true) {
+		cpu = z_percpu_cache_cpu_id();
+		lock = z_percpu_cache_lock_get(first, stride, cpu);
+		*key = k_spin_lock(lock);
+
+		if (cpu == z_percpu_cache_cpu_id()) {
+			return cpu;
+		}
+
+		k_spin_unlock(lock, *key);
+	}
+}
+
+static inline void z_percpu_cache_flush_all(struct k_spinlock *first,
+					    size_t stride, unsigned int count,
+					    z_percpu_cache_flush_t flush,
+					    void *obj)
+{
+	for (unsigned int cpu = 0; cpu < count; cpu++) {
+		struct k_spinlock *lock = z_percpu_cache_lock_get(first, stride, cpu);
+		k_spinlock_key_t key = k_spin_lock(lock);
+
+		flush(obj, cpu);
+
+		k_spin_unlock(lock, key);
+	}
+}
+
+/* Whether frees must bypass the caches and refills be skipped, to be
+ * checked with the lock of a cache held.
+ */
+static inline bool z_percpu_cache_has_waiters(atomic_t *waiters)
+{
+	return atomic_get(waiters) > 0;
+}
+
+static inline void z_percpu_cache_wait_begin(atomic_t *waiters,
+					     struct k_spinlock *first,
+					     size_t stride, unsigned int count,
+					     z_percpu_cache_flush_t flush,
+					     void *obj)
+{
+	atomic_inc(waiters);
+	z_percpu_cache_flush_all(first, stride, count, flush, obj);
+}
+
+static inline void z_percpu_cache_wait_end(atomic_t *waiters)
+{
+	atomic_dec(waiters);
+}
+
+/* Lock the cache of the current CPU in the array caches, returning it */
+#define Z_PERCPU_CACHE_LOCK(caches, key)				\
+	(&(caches)[z_percpu_cache_lock(&(caches)[0].lock,		\
+				       sizeof((caches)[0]), (key))])
+
+/* Flush all the caches of the array caches with flush(obj, cpu) */
+#define Z_PERCPU_CACHE_FLUSH_ALL(caches, flush, obj)			\
+	z_percpu_cache_flush_all(&(caches)[0].lock, sizeof((caches)[0]),	\
+				 ARRAY_SIZE(caches), (flush), (obj))
+
+/* Announce a waiter on the free list and flush all the caches to it */
+#define Z_PERCPU_CACHE_WAIT_BEGIN(waiters, caches, flush, obj)		\
+	z_percpu_cache_wait_begin((waiters), &(caches)[0].lock,		\
+				  sizeof((caches)[0]), ARRAY_SIZE(caches),	\
+				  (flush), (obj))
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_PERCPU_CACHE_H_ */
@@ -5,18 +5,147 @@
  */
 
 #include <zephyr/kernel.h>
+#include <string.h>
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
+#include <percpu_cache.h>
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+
+/* Size class i holds blocks of at least CACHE_MIN_SIZE << i bytes */
+#define CACHE_MIN_SIZE 16
+#define CACHE_MAX_SIZE (CACHE_MIN_SIZE << (CONFIG_K_HEAP_CPU_CACHE_CLASSES - 1))
+#define CACHE_DEPTH    CONFIG_K_HEAP_CPU_CACHE_DEPTH
+#define CACHE_BATCH    (CACHE_DEPTH / 2)
+
+/* Smallest size class serving an allocation of bytes */
+static inline int alloc_class(size_t bytes)
+{
+	return bytes <= CACHE_MIN_SIZE ? 0 : LOG2CEIL(bytes) - LOG2(CACHE_MIN_SIZE);
+}
+
+/* Largest size class a free block of usable bytes can serve, blocks much
+ * larger than the largest class are not worth caching.
+ */
+static inline int free_class(size_t usable)
+{
+	if (usable < CACHE_MIN_SIZE || usable >= 2 * CACHE_MAX_SIZE) {
+		return -1;
+	}
+
+	return LOG2(usable) - LOG2(CACHE_MIN_SIZE);
+}
+
+static void *cache_alloc(struct k_heap *heap, size_t bytes)
+{
+	int cls = alloc_class(bytes);
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key, heap_key;
+	void *mem = NULL;
+
+	cache = Z_PERCPU_CACHE_LOCK(heap->cpu_cache, &key);
+
+	/* On a miss take half a cache worth of blocks from the heap at once,
+	 * unless a thread is waiting for memory.
+	 */
+	if (cache->count[cls] == 0 && !z_percpu_cache_has_waiters(&heap->waiters)) {
+		heap_key = k_spin_lock(&heap->lock);
+
+		while (cache->count[cls] < CACHE_BATCH) {
+			mem = sys_heap_alloc(&heap->heap, CACHE_MIN_SIZE << cls);
+			if (mem == NULL) {
+				break;
+			}
+
+			cache->blocks[cls][cache->count[cls]++] = mem;
+		}
+
+		k_spin_unlock(&heap->lock, heap_key);
+	}
+
+	mem = NULL;
+	if (cache->count[cls] > 0) {
+		mem = cache->blocks[cls][--cache->count[cls]];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+static bool cache_free(struct k_heap *heap, void *mem)
+{
+	int cls = free_class(sys_heap_usable_size(&heap->heap, mem));
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key, heap_key;
+
+	if (cls < 0) {
+		return false;
+	}
+
+	cache = Z_PERCPU_CACHE_LOCK(heap->cpu_cache, &key);
+
+	/* Waiters must be woken up by the heap, see k_heap_aligned_alloc() */
+	if (z_percpu_cache_has_waiters(&heap->waiters)) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (cache->count[cls] == CACHE_DEPTH) {
+		/* Give the older half back, the newer blocks are more likely
+		 * to still be in the CPU data cache.
+		 */
+		heap_key = k_spin_lock(&heap->lock);
+
+		for (int i = 0; i < CACHE_BATCH; i++) {
+			sys_heap_free(&heap->heap, cache->blocks[cls][i]);
+		}
+
+		k_spin_unlock(&heap->lock, heap_key);
+
+		memmove(&cache->blocks[cls][0], &cache->blocks[cls][CACHE_BATCH],
+			(CACHE_DEPTH - CACHE_BATCH) * sizeof(void *));
+		cache->count[cls] -= CACHE_BATCH;
+	}
+
+	cache->blocks[cls][cache->count[cls]++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+static void cache_flush(void *obj, unsigned int cpu)
+{
+	struct k_heap *heap = obj;
+	struct z_heap_cpu_cache *cache = &heap->cpu_cache[cpu];
+	k_spinlock_key_t heap_key = k_spin_lock(&heap->lock);
+
+	for (int cls = 0; cls < ARRAY_SIZE(cache->count); cls++) {
+		while (cache->count[cls] > 0) {
+			sys_heap_free(&heap->heap, cache->blocks[cls][--cache->count[cls]]);
+		}
+	}
+
+	k_spin_unlock(&heap->lock, heap_key);
+}
+
+#endif /* CONFIG_K_HEAP_CPU_CACHE */
 
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	atomic_set(&heap->waiters, 0);
+	memset(heap->cpu_cache, 0, sizeof(heap->cpu_cache));
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
 
@@ -68,6 +197,20 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	/* Any block returned by sys_heap_alloc() is pointer aligned */
+	if (bytes > 0 && bytes <= CACHE_MAX_SIZE && align <= sizeof(void *)) {
+		ret = cache_alloc(heap, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+			return ret;
+		}
+	}
+
+	bool flushed = false;
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +222,21 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+		/* The memory may be held by the CPU caches. Keep them out of
+		 * the way until this allocation is done, so that frees wake
+		 * us up, and try again with their blocks back in the heap.
+		 */
+		if (ret == NULL && !flushed) {
+			flushed = true;
+			k_spin_unlock(&heap->lock, key);
+			Z_PERCPU_CACHE_WAIT_BEGIN(&heap->waiters, heap->cpu_cache,
+						  cache_flush, heap);
+			key = k_spin_lock(&heap->lock);
+			continue;
+		}
+#endif
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -102,6 +260,13 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	if (flushed) {
+		z_percpu_cache_wait_end(&heap->waiters);
+	}
+#endif
+
 	return ret;
 }
 
@@ -118,6 +283,13 @@ void *k_heap_alloc(struct k_heap *heap, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	if (mem != NULL && cache_free(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
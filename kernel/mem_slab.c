@@ -17,6 +17,168 @@
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
+#include <percpu_cache.h>
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+#define CACHE_DEPTH CONFIG_MEM_SLAB_CPU_CACHE_DEPTH
+#define CACHE_BATCH (CACHE_DEPTH / 2)
+
+/* Blocks in the CPU caches are part of info.num_used, and the counts of
+ * the caches change under their own locks, so the blocks handed out are
+ * counted on their own as they are allocated and freed.
+ */
+static uint32_t num_used_locked(struct k_mem_slab *slab)
+{
+	return (uint32_t)atomic_get(&slab->in_use);
+}
+
+/* Give the blocks of a locked cache list back to the slab */
+static void cache_put_list(struct k_mem_slab *slab, char *first, uint32_t count)
+{
+	k_spinlock_key_t key;
+	char *last = first;
+
+	while (*(char **)last != NULL) {
+		last = *(char **)last;
+	}
+
+	key = k_spin_lock(&slab->lock);
+
+	*(char **)last = slab->free_list;
+	slab->free_list = first;
+	slab->info.num_used -= count;
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+static void *cache_alloc(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key, slab_key;
+	char *mem = NULL;
+
+	cache = Z_PERCPU_CACHE_LOCK(slab->cpu_cache, &key);
+
+	/* On a miss take half a cache worth of blocks from the slab at once,
+	 * unless a thread is waiting for a block.
+	 */
+	if (cache->count == 0 && !z_percpu_cache_has_waiters(&slab->waiters)) {
+		slab_key = k_spin_lock(&slab->lock);
+
+		while (cache->count < CACHE_BATCH && slab->free_list != NULL) {
+			mem = slab->free_list;
+			slab->free_list = *(char **)mem;
+			*(char **)mem = cache->free_list;
+			cache->free_list = mem;
+			cache->count++;
+			slab->info.num_used++;
+		}
+
+		k_spin_unlock(&slab->lock, slab_key);
+	}
+
+	mem = cache->free_list;
+	if (mem != NULL) {
+		cache->free_list = *(char **)mem;
+		cache->count--;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t key;
+
+	cache = Z_PERCPU_CACHE_LOCK(slab->cpu_cache, &key);
+
+	/* Waiters must be handed the block by the slab */
+	if (z_percpu_cache_has_waiters(&slab->waiters)) {
+		k_spin_unlock(&cache->lock, key);
+		return false;
+	}
+
+	if (cache->count == CACHE_DEPTH) {
+		/* Keep the most recently freed half, which is more likely to
+		 * still be in the CPU data cache.
+		 */
+		char **link = &cache->free_list;
+
+		for (int i = 0; i < CACHE_DEPTH - CACHE_BATCH; i++) {
+			link = (char **)*link;
+		}
+
+		cache_put_list(slab, *link, CACHE_BATCH);
+		*link = NULL;
+		cache->count -= CACHE_BATCH;
+	}
+
+	*(char **)mem = cache->free_list;
+	cache->free_list = mem;
+	cache->count++;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+static void cache_flush(void *obj, unsigned int cpu)
+{
+	struct k_mem_slab *slab = obj;
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[cpu];
+
+	if (cache->count > 0) {
+		cache_put_list(slab, cache->free_list, cache->count);
+		cache->free_list = NULL;
+		cache->count = 0;
+	}
+}
+
+/* Count a block handed out, after it left the slab or a cache */
+static void count_alloc(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	uint32_t in_use = atomic_inc(&slab->in_use) + 1;
+	k_spinlock_key_t key;
+
+	if (in_use > slab->info.max_used) {
+		key = k_spin_lock(&slab->lock);
+		slab->info.max_used = MAX(in_use, slab->info.max_used);
+		k_spin_unlock(&slab->lock, key);
+	}
+#else
+	atomic_inc(&slab->in_use);
+#endif
+}
+
+/* Count a block given back, before it reaches the slab or a cache */
+static inline void count_free(struct k_mem_slab *slab)
+{
+	atomic_dec(&slab->in_use);
+}
+
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = num_used_locked(slab);
+
+	k_spin_unlock(&slab->lock, key);
+
+	return num_used;
+}
+
+#else
+
+static inline uint32_t num_used_locked(struct k_mem_slab *slab)
+{
+	return slab->info.num_used;
+}
+
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
@@ -33,6 +195,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = num_used_locked(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -45,12 +208,14 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t num_used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	num_used = num_used_locked(slab);
+	ptr->free_bytes = (slab->info.num_blocks - num_used) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = num_used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -72,7 +237,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	key = k_spin_lock(&slab->lock);
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = num_used_locked(slab);
 #endif
 
 	k_spin_unlock(&slab->lock, key);
@@ -184,6 +349,12 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_set(&slab->waiters, 0);
+	atomic_set(&slab->in_use, 0);
+	memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -205,7 +376,7 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+static int mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
@@ -218,7 +389,7 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		slab->free_list = *(char **)(slab->free_list);
 		slab->info.num_used++;
 
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && !defined(CONFIG_MEM_SLAB_CPU_CACHE)
 		slab->info.max_used = MAX(slab->info.num_used,
 					  slab->info.max_used);
 #endif
@@ -250,16 +421,58 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	int result;
+
+	*mem = cache_alloc(slab);
+	if (*mem != NULL) {
+		count_alloc(slab);
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	/* The slab ran empty, but its blocks may be held by the caches of
+	 * other CPUs. Give them back first, and keep frees away from the
+	 * caches until we are done so that they hand us a block if we pend.
+	 */
+	Z_PERCPU_CACHE_WAIT_BEGIN(&slab->waiters, slab->cpu_cache, cache_flush, slab);
+
+	result = mem_slab_alloc(slab, mem, timeout);
+	if (result == 0) {
+		count_alloc(slab);
+	}
+
+	z_percpu_cache_wait_end(&slab->waiters);
+
+	return result;
+#else
+	return mem_slab_alloc(slab, mem, timeout);
+#endif
+}
 
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
 	__ASSERT(((char *)mem >= slab->buffer) &&
 		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
 		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
 						  (slab->info.num_blocks - 1)))),
 		 "Invalid memory pointer provided");
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	count_free(slab);
+
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
@@ -289,9 +502,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = num_used_locked(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -314,7 +528,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	slab->info.max_used = num_used_locked(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
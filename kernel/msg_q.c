@@ -36,6 +36,59 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+/* Number of messages in the ring buffer, including the ones held back by
+ * a reservation.
+ */
+static inline uint32_t num_queued(struct k_msgq *msgq)
+{
+	return msgq->used_msgs + msgq->reserved_msgs;
+}
+
+/* Copy messages to the ring buffer. While the queue has a reservation they
+ * are held back, as they must be received after the reserved message.
+ */
+static void ring_write(struct k_msgq *msgq, const char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->write_ptr;
+
+	__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+			msgq->write_ptr < msgq->buffer_end);
+
+	if (len < to_end) {
+		(void)memcpy(msgq->write_ptr, data, len);
+		msgq->write_ptr += len;
+	} else {
+		(void)memcpy(msgq->write_ptr, data, to_end);
+		(void)memcpy(msgq->buffer_start, data + to_end, len - to_end);
+		msgq->write_ptr = msgq->buffer_start + (len - to_end);
+	}
+
+	if (msgq->reserve_ptr != NULL) {
+		msgq->reserved_msgs += num_msgs;
+	} else {
+		msgq->used_msgs += num_msgs;
+	}
+}
+
+/* Copy messages out of the ring buffer */
+static void ring_read(struct k_msgq *msgq, char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->read_ptr;
+
+	if (len < to_end) {
+		(void)memcpy(data, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	} else {
+		(void)memcpy(data, msgq->read_ptr, to_end);
+		(void)memcpy(data + to_end, msgq->buffer_start, len - to_end);
+		msgq->read_ptr = msgq->buffer_start + (len - to_end);
+	}
+
+	msgq->used_msgs -= num_msgs;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -46,6 +99,8 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+	msgq->reserve_ptr = NULL;
+	msgq->reserved_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
@@ -110,6 +165,13 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 		return -EBUSY;
 	}
 
+	/* The buffer is still written by the owner of the reservation */
+	if (msgq->reserve_ptr != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	if ((msgq->flags & K_MSGQ_FLAG_ALLOC) != 0U) {
 		k_free(msgq->buffer_start);
 		msgq->flags &= ~K_MSGQ_FLAG_ALLOC;
@@ -133,9 +195,14 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
-		/* message queue isn't full */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (num_queued(msgq) < msgq->max_msgs) {
+		/* message queue isn't full, threads waiting on it are receivers,
+		 * which must not overtake a reserved message
+		 */
+		pending_thread = NULL;
+		if (msgq->reserved_msgs == 0U) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		}
 		if (pending_thread != NULL) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
 
@@ -149,21 +216,19 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 			return 0;
 		} else {
 			/* put message in queue */
-			__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
-					msgq->write_ptr < msgq->buffer_end);
-			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+			ring_write(msgq, data, 1);
 #ifdef CONFIG_POLL
-			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+			if (msgq->used_msgs > 0U) {
+				handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+			}
 #endif /* CONFIG_POLL */
 		}
 		result = 0;
-	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		/* don't wait for message space to become available */
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || msgq->reserve_ptr != NULL) {
+		/* don't wait for message space to become available, nor while
+		 * the queue has a reservation as receivers may then be waiting
+		 * too
+		 */
 		result = -ENOMSG;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
@@ -227,12 +292,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
-		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
-		msgq->used_msgs--;
+		ring_read(msgq, data, 1);
 
 		/* handle first thread waiting to write (if any) */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -240,15 +300,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
 
 			/* add thread's message to queue */
-			__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
-					msgq->write_ptr < msgq->buffer_end);
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
+			ring_write(msgq, pending_thread->base.swap_data, 1);
 
 			/* wake up waiting thread */
 			arch_thread_return_value_set(pending_thread, 0);
@@ -293,6 +345,241 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	const char *msg = data;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t n = 0U;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* give messages to waiting threads, which are receivers as long as
+	 * the queue is empty
+	 */
+	while (n < num_msgs && num_queued(msgq) == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data, msg + n * msgq->msg_size,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+		n++;
+	}
+
+	/* queue as many of the other messages as fit */
+	if (n < num_msgs && num_queued(msgq) < msgq->max_msgs) {
+		uint32_t count = MIN(num_msgs - n, msgq->max_msgs - num_queued(msgq));
+
+		ring_write(msgq, msg + n * msgq->msg_size, count);
+		n += count;
+#ifdef CONFIG_POLL
+		if (msgq->used_msgs > 0U) {
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+		}
+#endif /* CONFIG_POLL */
+	}
+
+	if (n > 0U) {
+		if (resched) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+
+		return n;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || msgq->reserve_ptr != NULL) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -ENOMSG;
+	}
+
+	/* wait for room for the first message, like k_msgq_put() */
+	_current->base.swap_data = (void *)data;
+
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+	return (result == 0) ? 1 : result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t n;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	n = MIN(num_msgs, msgq->used_msgs);
+	if (n > 0U) {
+		/* take the first available messages from queue */
+		ring_read(msgq, data, n);
+
+		/* queue the messages of threads waiting to write, which are
+		 * senders as the queue was not empty
+		 */
+		while (num_queued(msgq) < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			ring_write(msgq, pending_thread->base.swap_data, 1);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+
+		if (resched) {
+			z_reschedule(&msgq->lock, key);
+		} else {
+			k_spin_unlock(&msgq->lock, key);
+		}
+
+		return n;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -ENOMSG;
+	}
+
+	/* wait for one message, like k_msgq_get() */
+	_current->base.swap_data = data;
+
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+	return (result == 0) ? 1 : result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
+int k_msgq_put_reserve(struct k_msgq *msgq, void **msg)
+{
+	k_spinlock_key_t key;
+	int result = 0;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->reserve_ptr != NULL) {
+		result = -EBUSY;
+	} else if (num_queued(msgq) == msgq->max_msgs) {
+		result = -ENOMSG;
+	} else {
+		msgq->reserve_ptr = msgq->write_ptr;
+		msgq->reserved_msgs = 1U;
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		*msg = msgq->reserve_ptr;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_put_commit(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	CHECKIF(msgq->reserve_ptr == NULL) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	/* threads waiting on an empty queue are receivers, hand them the
+	 * messages held back so far
+	 */
+	if (msgq->used_msgs == 0U) {
+		msgq->used_msgs = msgq->reserved_msgs;
+
+		while (msgq->used_msgs > 0U) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			ring_read(msgq, pending_thread->base.swap_data, 1);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+	} else {
+		msgq->used_msgs += msgq->reserved_msgs;
+	}
+
+	msgq->reserve_ptr = NULL;
+	msgq->reserved_msgs = 0U;
+
+#ifdef CONFIG_POLL
+	if (msgq->used_msgs > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -389,7 +676,18 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	}
 
 	msgq->used_msgs = 0;
-	msgq->read_ptr = msgq->write_ptr;
+
+	if (msgq->reserve_ptr != NULL) {
+		/* keep the reserved message, but not the ones sent after it */
+		msgq->reserved_msgs = 1U;
+		msgq->read_ptr = msgq->reserve_ptr;
+		msgq->write_ptr = msgq->reserve_ptr + msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+	} else {
+		msgq->read_ptr = msgq->write_ptr;
+	}
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <ksched.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/math_extras.h>
 
 static inline void flag_clear(uint32_t *flagp,
 			      uint32_t bit)
@@ -820,6 +821,119 @@ int k_work_queue_unplug(struct k_work_q *queue)
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+static struct k_work_delayable_stats delayable_stats;
+static k_ticks_t last_expiry = -1;
+/* Whether an expiry moved by slack on last_expiry is not counted yet */
+static bool last_uncounted;
+
+/* Count a delayable work timeout expiring on the current tick.
+ *
+ * Every expiry but the first one of a tick shares its timer wakeup. It
+ * counts as coalesced if slack moved it, or an earlier expiry of the tick
+ * not counted yet, onto that tick: expiries which would have shared it
+ * anyway are not to the credit of slack.
+ *
+ * Invoked with work lock held.
+ */
+static void delayable_stats_expired(const struct k_work_delayable *dwork)
+{
+	k_ticks_t now = sys_clock_tick_get();
+
+	delayable_stats.expired++;
+
+	if (now != last_expiry) {
+		last_expiry = now;
+		last_uncounted = dwork->slacked;
+	} else if (dwork->slacked || last_uncounted) {
+		delayable_stats.coalesced++;
+		last_uncounted = dwork->slacked && last_uncounted;
+	}
+}
+
+/* Extend a delay within the slack of the work item, as the Linux timer
+ * slack does: the latest acceptable expiry is rounded down on the highest
+ * bit in which it differs from the requested one. Expiries whose slack
+ * windows overlap then tend to fall on the same tick.
+ *
+ * Invoked with work lock held.
+ */
+static k_timeout_t apply_slack(struct k_work_delayable *dwork,
+			       k_timeout_t delay)
+{
+	uint64_t now, expires, limit;
+
+	dwork->slacked = false;
+
+	if (dwork->slack == 0U || K_TIMEOUT_EQ(delay, K_FOREVER)) {
+		return delay;
+	}
+
+	now = sys_clock_tick_get();
+
+	if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) && Z_TICK_ABS(delay.ticks) >= 0) {
+		expires = Z_TICK_ABS(delay.ticks);
+		if (expires <= now) {
+			return delay;
+		}
+	} else {
+		/* Relative timeouts expire on the tick after the delay */
+		expires = now + delay.ticks + 1;
+	}
+
+	limit = expires + dwork->slack;
+	limit &= ~(BIT64(63 - u64_count_leading_zeros(expires ^ limit)) - 1);
+
+	if (limit == expires) {
+		return delay;
+	}
+
+	dwork->slacked = true;
+	delayable_stats.slacked++;
+
+#ifdef CONFIG_TIMEOUT_64BIT
+	return K_TIMEOUT_ABS_TICKS(limit);
+#else
+	return K_TICKS(limit - now - 1);
+#endif
+}
+
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(dwork != NULL);
+	__ASSERT_NO_MSG(!K_TIMEOUT_EQ(slack, K_FOREVER) && slack.ticks >= 0);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	dwork->slack = (uint32_t)slack.ticks;
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_work_delayable_stats_get(struct k_work_delayable_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = delayable_stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_work_delayable_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	delayable_stats = (struct k_work_delayable_stats){};
+	last_expiry = -1;
+	last_uncounted = false;
+
+	k_spin_unlock(&lock, key);
+}
+#endif /* CONFIG_WORK_DELAYABLE_SLACK */
+
 /* Timeout handler for delayable work.
  *
  * Invoked by timeout infrastructure.
@@ -834,6 +948,10 @@ static void work_timeout(struct _timeout *to)
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_work_q *queue = NULL;
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	delayable_stats_expired(dw);
+#endif
+
 	/* If the work is still marked delayed (should be) then clear that
 	 * state and submit it to the queue.  If successful the queue will be
 	 * notified of new work at the next reschedule point.
@@ -917,6 +1035,10 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	flag_set(&work->flags, K_WORK_DELAYED_BIT);
 	dwork->queue = *queuep;
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	delay = apply_slack(dwork, delay);
+#endif
+
 	/* Add timeout */
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
 
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/crc.h>
+
+#include "crc32_internal.h"
+
+const struct crc32_backend *z_crc32_backend;
+
+void crc32_backend_register(const struct crc32_backend *backend)
+{
+	z_crc32_backend = backend;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Shared implementation details of the reflected CRC32 algorithms
+ * (IEEE 802.3 and Castagnoli).  All helpers below operate on the raw
+ * CRC register: the callers take care of the initial value and final
+ * XOR.
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_
+#define ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+#ifdef CONFIG_CRC32_BACKEND
+extern const struct crc32_backend *z_crc32_backend;
+#endif
+
+#if defined(CONFIG_CRC32_SLICE_BY_8)
+#define CRC32_SLICES 8
+#elif defined(CONFIG_CRC32_SLICE_BY_4)
+#define CRC32_SLICES 4
+#endif
+
+#ifdef CRC32_SLICES
+static inline uint32_t crc32_slice_update(const uint32_t (*table)[256], uint32_t crc,
+					  const uint8_t *data, size_t len)
+{
+	/* Bring the pointer to a word boundary so the loop below
+	 * doesn't pay for unaligned accesses on the way.
+	 */
+	while ((len > 0) && (((uintptr_t)data & 3) != 0)) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xff];
+		len--;
+	}
+
+	while (len >= CRC32_SLICES) {
+		uint32_t one = sys_get_le32(data) ^ crc;
+
+#if CRC32_SLICES == 8
+		uint32_t two = sys_get_le32(data + 4);
+
+		crc = table[7][one & 0xff] ^
+		      table[6][(one >> 8) & 0xff] ^
+		      table[5][(one >> 16) & 0xff] ^
+		      table[4][one >> 24] ^
+		      table[3][two & 0xff] ^
+		      table[2][(two >> 8) & 0xff] ^
+		      table[1][(two >> 16) & 0xff] ^
+		      table[0][two >> 24];
+#else
+		crc = table[3][one & 0xff] ^
+		      table[2][(one >> 8) & 0xff] ^
+		      table[1][(one >> 16) & 0xff] ^
+		      table[0][one >> 24];
+#endif
+		data += CRC32_SLICES;
+		len -= CRC32_SLICES;
+	}
+
+	while (len-- > 0) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xff];
+	}
+
+	return crc;
+}
+#endif /* CRC32_SLICES */
+
+#if defined(CONFIG_CRC32_HW_ACCEL) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+
+#define CRC32_IEEE_HW 1
+#define CRC32C_HW 1
+
+static inline uint32_t crc32_ieee_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	while ((len > 0) && (((uintptr_t)data & 7) != 0)) {
+		crc = __crc32b(crc, *data++);
+		len--;
+	}
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32d(crc, sys_get_le64(data));
+	}
+	while (len-- > 0) {
+		crc = __crc32b(crc, *data++);
+	}
+
+	return crc;
+}
+
+static inline uint32_t crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	while ((len > 0) && (((uintptr_t)data & 7) != 0)) {
+		crc = __crc32cb(crc, *data++);
+		len--;
+	}
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32cd(crc, sys_get_le64(data));
+	}
+	while (len-- > 0) {
+		crc = __crc32cb(crc, *data++);
+	}
+
+	return crc;
+}
+
+#elif defined(CONFIG_CRC32_HW_ACCEL) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+
+/* The SSE4.2 crc32 instruction only implements the Castagnoli
+ * polynomial.
+ */
+#define CRC32C_HW 1
+
+static inline uint32_t crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+#ifdef __x86_64__
+	uint64_t crc64 = crc;
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc64 = _mm_crc32_u64(crc64, sys_get_le64(data));
+	}
+	crc = (uint32_t)crc64;
+#endif
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = _mm_crc32_u32(crc, sys_get_le32(data));
+	}
+	while (len-- > 0) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+
+	return crc;
+}
+#endif
+
+#endif /* ZEPHYR_LIB_CRC_CRC32_INTERNAL_H_ */
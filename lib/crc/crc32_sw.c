@@ -6,6 +6,12 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc32_internal.h"
+
+#if !defined(CRC32_IEEE_HW) && defined(CRC32_SLICES)
+#include "crc/crc32_ieee_table.h"
+#endif
+
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
 	return crc32_ieee_update(0x0, data, len);
@@ -13,6 +19,21 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#ifdef CONFIG_CRC32_BACKEND
+	const struct crc32_backend *backend = z_crc32_backend;
+
+	if ((backend != NULL) && (backend->ieee_update != NULL)) {
+		return ~backend->ieee_update(~crc, data, len);
+	}
+#endif
+
+	crc = ~crc;
+
+#if defined(CRC32_IEEE_HW)
+	crc = crc32_ieee_hw_update(crc, data, len);
+#elif defined(CRC32_SLICES)
+	crc = crc32_slice_update(crc32_ieee_table, crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU,
@@ -21,14 +42,13 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 		0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU,
 	};
 
-	crc = ~crc;
-
 	for (size_t i = 0; i < len; i++) {
 		uint8_t byte = data[i];
 
 		crc = (crc >> 4) ^ table[(crc ^ byte) & 0x0f];
 		crc = (crc >> 4) ^ table[(crc ^ ((uint32_t)byte >> 4)) & 0x0f];
 	}
+#endif
 
 	return (~crc);
 }
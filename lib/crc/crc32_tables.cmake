@@ -0,0 +1,36 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Generates the slice-by-4 or slice-by-8 CRC32 tables selected by the
+# configuration as <output_dir>/crc/crc32_ieee_table.h and
+# <output_dir>/crc/crc32c_table.h, and returns their paths in <headers>.
+function(crc32_generate_tables
+    output_dir # Include directory the tables are generated in
+    headers    # Variable set to the list of generated headers
+    )
+  if(CONFIG_CRC32_SLICE_BY_8)
+    set(slices 8)
+  else()
+    set(slices 4)
+  endif()
+
+  foreach(table crc32_ieee_table:0xEDB88320 crc32c_table:0x82F63B78)
+    string(REPLACE ":" ";" table ${table})
+    list(GET table 0 name)
+    list(GET table 1 poly)
+
+    add_custom_command(
+      OUTPUT ${output_dir}/crc/${name}.h
+      COMMAND
+      ${PYTHON_EXECUTABLE}
+      ${ZEPHYR_BASE}/scripts/build/gen_crc32_tables.py
+      -p ${poly}
+      -s ${slices}
+      -n ${name}
+      -o ${output_dir}/crc/${name}.h
+      DEPENDS ${ZEPHYR_BASE}/scripts/build/gen_crc32_tables.py
+    )
+    list(APPEND generated ${output_dir}/crc/${name}.h)
+  endforeach()
+
+  set(${headers} ${generated} PARENT_SCOPE)
+endfunction()
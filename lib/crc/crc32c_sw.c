@@ -6,6 +6,13 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc32_internal.h"
+
+#if defined(CRC32C_HW)
+/* CPU instructions, no table needed */
+#elif defined(CRC32_SLICES)
+#include "crc/crc32c_table.h"
+#else
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
@@ -13,6 +20,7 @@ static const uint32_t crc32c_table[16] = {
 	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -31,10 +39,25 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
+#ifdef CONFIG_CRC32_BACKEND
+	const struct crc32_backend *backend = z_crc32_backend;
+
+	if ((backend != NULL) && (backend->c_update != NULL)) {
+		crc = backend->c_update(crc, data, len);
+		return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
+	}
+#endif
+
+#if defined(CRC32C_HW)
+	crc = crc32c_hw_update(crc, data, len);
+#elif defined(CRC32_SLICES)
+	crc = crc32_slice_update(crc32c_table, crc, data, len);
+#else
 	for (size_t i = 0; i < len; i++) {
 		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
 		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
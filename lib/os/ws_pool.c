@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ws_pool.h>
+
+#define DEQUE_SIZE CONFIG_WS_POOL_DEQUE_SIZE
+
+/* The deques are short arrays under a lock of their own rather than
+ * lock-free Chase-Lev deques, which need memory barriers that not every
+ * supported architecture provides through the atomic API. The owner and
+ * the thieves only meet on the lock of a deque when it is being robbed.
+ */
+
+static bool push(struct z_ws_worker *w, struct k_ws_job *job)
+{
+	k_spinlock_key_t key = k_spin_lock(&w->lock);
+	bool ok = (w->tail - w->head) < DEQUE_SIZE;
+
+	if (ok) {
+		w->jobs[w->tail % DEQUE_SIZE] = job;
+		w->tail++;
+	}
+
+	k_spin_unlock(&w->lock, key);
+
+	return ok;
+}
+
+/* The owner takes the newest job, whose data is most likely still cached */
+static struct k_ws_job *pop(struct z_ws_worker *w)
+{
+	struct k_ws_job *job = NULL;
+	k_spinlock_key_t key;
+
+	if (w->tail == w->head) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&w->lock);
+
+	if (w->tail != w->head) {
+		w->tail--;
+		job = w->jobs[w->tail % DEQUE_SIZE];
+	}
+
+	k_spin_unlock(&w->lock, key);
+
+	return job;
+}
+
+/* Thieves take the oldest job, usually the largest part of a split task */
+static struct k_ws_job *steal(struct z_ws_worker *w)
+{
+	struct k_ws_job *job = NULL;
+	k_spinlock_key_t key;
+
+	if (w->tail == w->head) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&w->lock);
+
+	if (w->tail != w->head) {
+		job = w->jobs[w->head % DEQUE_SIZE];
+		w->head++;
+	}
+
+	k_spin_unlock(&w->lock, key);
+
+	return job;
+}
+
+static int current_worker(struct k_ws_pool *pool)
+{
+	struct k_thread *thread = k_current_get();
+
+	for (int i = 0; i < pool->num_workers; i++) {
+		if (thread == &pool->workers[i].thread) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static struct k_ws_job *find_job(struct k_ws_pool *pool, int self)
+{
+	struct z_ws_worker *w = &pool->workers[self];
+	struct k_ws_job *job;
+
+	job = pop(w);
+	if (job != NULL) {
+		return job;
+	}
+
+	/* Start with the next worker, so thieves spread over the victims */
+	for (int i = 1; i < pool->num_workers; i++) {
+		job = steal(&pool->workers[(self + i) % pool->num_workers]);
+		if (job != NULL) {
+			w->stolen++;
+			return job;
+		}
+	}
+
+	return NULL;
+}
+
+static void run_job(struct k_ws_job *job)
+{
+	/* The job may be released by its handler when it has no group */
+	struct k_ws_group *group = job->group;
+
+	job->handler(job);
+
+	if (group != NULL && atomic_dec(&group->pending) == 1) {
+		/* Last job of a group whose waiter is blocked */
+		k_sem_give(&group->done);
+	}
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	struct k_ws_pool *pool = p1;
+	int self = POINTER_TO_INT(p2);
+	struct z_ws_worker *w = &pool->workers[self];
+	struct k_ws_job *job;
+
+	ARG_UNUSED(p3);
+
+	while (true) {
+		job = find_job(pool, self);
+
+		if (job == NULL) {
+			/* Announce that we are idle before looking again, so a
+			 * job submitted meanwhile either is found or wakes us.
+			 */
+			atomic_inc(&pool->idle);
+
+			job = find_job(pool, self);
+			if (job == NULL) {
+				k_sem_take(&pool->wake, K_FOREVER);
+			}
+
+			atomic_dec(&pool->idle);
+
+			if (job == NULL) {
+				continue;
+			}
+		}
+
+		w->executed++;
+		run_job(job);
+	}
+}
+
+void k_ws_pool_start(struct k_ws_pool *pool, int prio)
+{
+	size_t stride = K_THREAD_STACK_LEN(pool->stack_size);
+
+	atomic_set(&pool->idle, 0);
+	atomic_set(&pool->next, 0);
+	k_sem_init(&pool->wake, 0, pool->num_workers);
+
+	for (int i = 0; i < pool->num_workers; i++) {
+		struct z_ws_worker *w = &pool->workers[i];
+
+		w->lock = (struct k_spinlock) {};
+		w->head = 0U;
+		w->tail = 0U;
+		w->executed = 0U;
+		w->stolen = 0U;
+
+		k_thread_create(&w->thread, &pool->stacks[stride * i],
+				pool->stack_size, worker_entry, pool,
+				INT_TO_POINTER(i), NULL, prio, 0, K_FOREVER);
+#ifdef CONFIG_THREAD_NAME
+		char name[CONFIG_THREAD_MAX_NAME_LEN];
+
+		snprintk(name, sizeof(name), "ws_pool%02d", i);
+		k_thread_name_set(&w->thread, name);
+#endif
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&w->thread, i % arch_num_cpus());
+#endif
+		k_thread_start(&w->thread);
+	}
+}
+
+void k_ws_group_init(struct k_ws_group *group)
+{
+	/* The waiter holds one count until it blocks, so that jobs only give
+	 * the semaphore when it is actually waited on.
+	 */
+	atomic_set(&group->pending, 1);
+	k_sem_init(&group->done, 0, 1);
+}
+
+void k_ws_pool_submit(struct k_ws_pool *pool, struct k_ws_group *group,
+		      struct k_ws_job *job)
+{
+	int self = current_worker(pool);
+	bool queued = false;
+
+	job->group = group;
+	if (group != NULL) {
+		atomic_inc(&group->pending);
+	}
+
+	if (self >= 0) {
+		queued = push(&pool->workers[self], job);
+	} else {
+		uint32_t first = (uint32_t)atomic_inc(&pool->next);
+
+		for (int i = 0; i < pool->num_workers && !queued; i++) {
+			queued = push(&pool->workers[(first + i) % pool->num_workers], job);
+		}
+	}
+
+	if (!queued) {
+		run_job(job);
+		return;
+	}
+
+	if (atomic_get(&pool->idle) > 0) {
+		k_sem_give(&pool->wake);
+	}
+}
+
+void k_ws_group_wait(struct k_ws_pool *pool, struct k_ws_group *group)
+{
+	int self = current_worker(pool);
+	struct k_ws_job *job;
+
+	if (self >= 0) {
+		/* Blocking could leave the jobs waited for on our own deque,
+		 * so run jobs as long as there are any to be found. The jobs
+		 * of the group still pending are then running on other
+		 * workers, which give the semaphore when done.
+		 */
+		while (atomic_get(&group->pending) > 1) {
+			job = find_job(pool, self);
+			if (job == NULL) {
+				break;
+			}
+
+			pool->workers[self].executed++;
+			run_job(job);
+		}
+	}
+
+	if (atomic_dec(&group->pending) != 1) {
+		k_sem_take(&group->done, K_FOREVER);
+	}
+
+	atomic_set(&group->pending, 1);
+}
+
+struct range_job {
+	struct k_ws_job job;
+	k_ws_range_fn_t fn;
+	void *arg;
+	uint32_t begin;
+	uint32_t end;
+};
+
+static void range_handler(struct k_ws_job *job)
+{
+	struct range_job *r = CONTAINER_OF(job, struct range_job, job);
+
+	r->fn(r->begin, r->end, r->arg);
+}
+
+void k_ws_parallel_for(struct k_ws_pool *pool, uint32_t begin, uint32_t end,
+		       uint32_t grain, k_ws_range_fn_t fn, void *arg)
+{
+	struct range_job jobs[CONFIG_WS_POOL_PARALLEL_FOR_JOBS];
+	struct k_ws_group group;
+	uint32_t count, n_jobs, size, extra;
+
+	if (end <= begin) {
+		return;
+	}
+
+	count = end - begin;
+	n_jobs = MIN(DIV_ROUND_UP(count, MAX(grain, 1U)),
+		     CONFIG_WS_POOL_PARALLEL_FOR_JOBS);
+	size = count / n_jobs;
+	extra = count % n_jobs;
+
+	for (uint32_t i = 0; i < n_jobs; i++) {
+		jobs[i].job.handler = range_handler;
+		jobs[i].fn = fn;
+		jobs[i].arg = arg;
+		jobs[i].begin = begin;
+		begin += size + (i < extra ? 1U : 0U);
+		jobs[i].end = begin;
+	}
+
+	k_ws_group_init(&group);
+
+	/* Submit the last ranges first, so the owner of the deque works
+	 * through them in order while thieves take the other end.
+	 */
+	for (uint32_t i = n_jobs - 1; i > 0; i--) {
+		k_ws_pool_submit(pool, &group, &jobs[i].job);
+	}
+
+	fn(jobs[0].begin, jobs[0].end, arg);
+
+	k_ws_group_wait(pool, &group);
+}
+
+void k_ws_pool_stats_get(struct k_ws_pool *pool, struct k_ws_pool_stats *stats)
+{
+	stats->executed = 0U;
+	stats->stolen = 0U;
+
+	for (int i = 0; i < pool->num_workers; i++) {
+		stats->executed += pool->workers[i].executed;
+		stats->stolen += pool->workers[i].stolen;
+	}
+}
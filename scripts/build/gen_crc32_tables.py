@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the lookup tables used by the slice-by-N implementations of
+the reflected CRC32 algorithms in lib/crc.
+
+Table 0 is the classic byte-wise table for the (reflected) polynomial,
+table k gives the contribution of a byte that is followed by k more
+bytes of input.
+"""
+
+import argparse
+import os
+
+
+def gen_tables(poly, slices):
+    tables = [[0] * 256 for _ in range(slices)]
+
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ poly if crc & 1 else crc >> 1
+        tables[0][n] = crc
+
+    for k in range(1, slices):
+        for n in range(256):
+            prev = tables[k - 1][n]
+            tables[k][n] = (prev >> 8) ^ tables[0][prev & 0xff]
+
+    return tables
+
+
+def write_header(output, name, poly, slices):
+    tables = gen_tables(poly, slices)
+
+    os.makedirs(os.path.dirname(output), exist_ok=True)
+
+    with open(output, 'w') as outf:
+        print(f'''/*
+ * This file generated by {__file__}
+ */
+
+#include <stdint.h>
+
+/* Slice-by-{slices} tables for reflected polynomial 0x{poly:08X} */
+static const uint32_t {name}[{slices}][256] = {{''', file=outf)
+
+        for table in tables:
+            print('\t{', file=outf)
+            for row in range(0, 256, 4):
+                words = ', '.join(f'0x{v:08X}U' for v in table[row:row + 4])
+                print(f'\t\t{words},', file=outf)
+            print('\t},', file=outf)
+
+        print('};', file=outf)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(allow_abbrev=False)
+    parser.add_argument('-p', '--poly', required=True,
+                        help='reflected polynomial, e.g. 0xEDB88320')
+    parser.add_argument('-s', '--slices', type=int, choices=[4, 8],
+                        required=True, help='number of slice tables')
+    parser.add_argument('-n', '--name', required=True,
+                        help='name of the generated table')
+    parser.add_argument('-o', '--output', required=True,
+                        help='output header file')
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    write_header(args.output, args.name, int(args.poly, 0), args.slices)
+
+
+if __name__ == '__main__':
+    main()
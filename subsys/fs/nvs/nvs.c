@@ -19,9 +19,7 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +31,14 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +89,175 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_ID_INDEX
+
+/* The ID index is an open addressed hash table (linear probing) that maps
+ * every NVS ID to the address of its most recent valid ATE. Unlike the
+ * lookup cache it stores the ID next to the address, so a hit is exact and
+ * never needs an ATE walk. The table is never filled beyond 3/4 of its
+ * slots; IDs that don't fit are left out and the index is marked as
+ * incomplete, in which case only misses fall back to walking the ATEs.
+ */
+
+#define NVS_ID_INDEX_MASK	(CONFIG_NVS_ID_INDEX_SIZE - 1)
+#define NVS_ID_INDEX_MAX_USED	(CONFIG_NVS_ID_INDEX_SIZE * 3 / 4)
+#define NVS_ID_INDEX_EMPTY	0xFFFF
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NVS_ID_INDEX_SIZE),
+	     "CONFIG_NVS_ID_INDEX_SIZE must be a power of 2");
+
+static inline size_t nvs_id_index_home(uint16_t id)
+{
+	return nvs_id_hash(id) & NVS_ID_INDEX_MASK;
+}
+
+/* Return the slot holding id, or the empty slot where it would be added */
+static size_t nvs_id_index_slot(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_id_index_home(id);
+
+	while ((fs->id_index_ids[pos] != id) &&
+	       (fs->id_index_ids[pos] != NVS_ID_INDEX_EMPTY)) {
+		pos = (pos + 1) & NVS_ID_INDEX_MASK;
+	}
+
+	return pos;
+}
+
+static void nvs_id_index_reset(struct nvs_fs *fs, bool complete)
+{
+	memset(fs->id_index_ids, 0xff, sizeof(fs->id_index_ids));
+	fs->id_index_used = 0U;
+	fs->id_index_complete = complete;
+}
+
+/* Return the ATE address to start a lookup of id from: the exact ATE if id
+ * is indexed, NVS_LOOKUP_CACHE_NO_ADDR if id is known not to exist and
+ * ate_wra (walk everything) if the index can't tell.
+ */
+static uint32_t nvs_id_index_get(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos;
+
+	/* 0xFFFF is a special-purpose identifier, it is never indexed */
+	if (id == NVS_ID_INDEX_EMPTY) {
+		return fs->ate_wra;
+	}
+
+	pos = nvs_id_index_slot(fs, id);
+	if (fs->id_index_ids[pos] == id) {
+		return fs->id_index_addr[pos];
+	}
+
+	return fs->id_index_complete ? NVS_LOOKUP_CACHE_NO_ADDR : fs->ate_wra;
+}
+
+static void nvs_id_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	size_t pos = nvs_id_index_slot(fs, id);
+
+	if (fs->id_index_ids[pos] != id) {
+		if (fs->id_index_used >= NVS_ID_INDEX_MAX_USED) {
+			if (fs->id_index_complete) {
+				LOG_WRN("ID index full, consider increasing "
+					"CONFIG_NVS_ID_INDEX_SIZE");
+				fs->id_index_complete = false;
+			}
+			return;
+		}
+		fs->id_index_ids[pos] = id;
+		fs->id_index_used++;
+	}
+
+	fs->id_index_addr[pos] = addr;
+}
+
+/* Remove the entry in slot pos, shifting later entries of the same probe
+ * sequence back so no tombstones are needed.
+ */
+static void nvs_id_index_remove(struct nvs_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	while (true) {
+		next = (next + 1) & NVS_ID_INDEX_MASK;
+		if (fs->id_index_ids[next] == NVS_ID_INDEX_EMPTY) {
+			break;
+		}
+
+		/* The entry can fill the hole unless its home slot lies
+		 * (cyclically) between the hole and the entry itself.
+		 */
+		home = nvs_id_index_home(fs->id_index_ids[next]);
+		if (((next - home) & NVS_ID_INDEX_MASK) >=
+		    ((next - pos) & NVS_ID_INDEX_MASK)) {
+			fs->id_index_ids[pos] = fs->id_index_ids[next];
+			fs->id_index_addr[pos] = fs->id_index_addr[next];
+			pos = next;
+		}
+	}
+
+	fs->id_index_ids[pos] = NVS_ID_INDEX_EMPTY;
+	fs->id_index_used--;
+}
+
+static int nvs_id_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_id_index_reset(fs, true);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* Walking backwards, the first valid ATE seen for an ID is
+		 * its most recent one.
+		 */
+		if (ate.id != NVS_ID_INDEX_EMPTY && nvs_ate_valid(fs, &ate) &&
+		    fs->id_index_ids[nvs_id_index_slot(fs, ate.id)] != ate.id) {
+			nvs_id_index_set(fs, ate.id, ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	LOG_DBG("ID index: %u IDs%s", fs->id_index_used,
+		fs->id_index_complete ? "" : " (incomplete)");
+
+	return 0;
+}
+
+static void nvs_id_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t pos = 0;
+
+	/* A removal may shift a not yet visited entry into pos, so only
+	 * advance when the slot is kept.
+	 */
+	while (pos < CONFIG_NVS_ID_INDEX_SIZE) {
+		if ((fs->id_index_ids[pos] != NVS_ID_INDEX_EMPTY) &&
+		    ((fs->id_index_addr[pos] >> ADDR_SECT_SHIFT) == sector)) {
+			nvs_id_index_remove(fs, pos);
+		} else {
+			pos++;
+		}
+	}
+}
+
+#endif /* CONFIG_NVS_ID_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +342,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	/* 0xFFFF is a special-purpose identifier. Exclude it from the index */
+	if (!rc && entry->id != 0xFFFF) {
+		nvs_id_index_set(fs, entry->id, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -307,6 +486,8 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#elif defined(CONFIG_NVS_ID_INDEX)
+	nvs_id_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -582,23 +763,27 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
+ *
+ * gc is split in three phases so it can also be run in steps from the
+ * background: nvs_gc_start() locates the ATEs to collect, nvs_gc_copy() moves
+ * the live entries into the new sector and nvs_gc_finish() marks the gc as
+ * done and erases the collected sector.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, uint32_t *sec_addr, uint32_t *gc_addr,
+			uint32_t *stop_addr)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	*sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, sec_addr);
+	*gc_addr = *sec_addr + fs->sector_size - ate_size;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, *gc_addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -606,28 +791,57 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		*gc_addr = NVS_GC_NO_ADDR;
+		*stop_addr = NVS_GC_NO_ADDR;
+		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
+#ifdef CONFIG_NVS_GC_STATS
+	fs->gc_stats.gc_runs++;
+#endif
+
+	*stop_addr = *gc_addr - ate_size;
 
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
+		*gc_addr &= ADDR_SECT_MASK;
+		*gc_addr += close_ate.offset;
 	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
+		rc = nvs_recover_last_ate(fs, gc_addr);
 		if (rc) {
 			return rc;
 		}
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+	return 0;
+}
+
+/* Process at most max_ates ATEs of the sector being gc'ed. Returns 0 when the
+ * whole sector has been processed, 1 if there is more left to do.
+ */
+static int nvs_gc_copy(struct nvs_fs *fs, uint32_t *gc_addr, uint32_t stop_addr,
+		       uint32_t max_ates)
+{
+	int rc;
+	struct nvs_ate gc_ate, wlk_ate;
+	uint32_t gc_prev_addr, wlk_addr, wlk_prev_addr, data_addr;
+
+	while (*gc_addr != NVS_GC_NO_ADDR) {
+		if (max_ates-- == 0U) {
+			return 1;
+		}
+
+		gc_prev_addr = *gc_addr;
+		rc = nvs_prev_ate(fs, gc_addr, &gc_ate);
 		if (rc) {
+			*gc_addr = gc_prev_addr;
 			return rc;
 		}
 
+		if (gc_prev_addr == stop_addr) {
+			/* this is the last ATE of the sector */
+			*gc_addr = NVS_GC_NO_ADDR;
+		}
+
 		if (!nvs_ate_valid(fs, &gc_ate)) {
 			continue;
 		}
@@ -635,6 +849,12 @@ static int nvs_gc(struct nvs_fs *fs)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
 
+		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+			wlk_addr = fs->ate_wra;
+		}
+#elif defined(CONFIG_NVS_ID_INDEX)
+		wlk_addr = nvs_id_index_get(fs, gc_ate.id);
+
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
 		}
@@ -680,10 +900,22 @@ static int nvs_gc(struct nvs_fs *fs)
 			if (rc) {
 				return rc;
 			}
+#ifdef CONFIG_NVS_GC_STATS
+			fs->gc_stats.bytes_moved += gc_ate.len;
+#endif
 		}
-	} while (gc_prev_addr != stop_addr);
+	}
+
+	return 0;
+}
 
-gc_done:
+static int nvs_gc_finish(struct nvs_fs *fs, uint32_t sec_addr)
+{
+	int rc;
+	size_t ate_size;
+	bool gc_done_marked = false;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -696,16 +928,181 @@ gc_done:
 		if (rc) {
 			return rc;
 		}
+		gc_done_marked = true;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	fs->gc_fresh = true;
+
+	/* Once the gc done ate is written the erase can safely be left to the
+	 * background: if it is interrupted nvs_startup() erases the sector.
+	 * Without the gc done ate the sector is erased right away.
+	 */
+	if (gc_done_marked) {
+		fs->gc_sec_addr = sec_addr;
+		fs->gc_state = NVS_GC_STATE_ERASE;
+		return 0;
+	}
+#else
+	ARG_UNUSED(gc_done_marked);
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (rc == 0) {
+		fs->gc_state = NVS_GC_STATE_IDLE;
+	}
+#endif
+
+	return rc;
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t sec_addr, gc_addr, stop_addr;
+
+	rc = nvs_gc_start(fs, &sec_addr, &gc_addr, &stop_addr);
 	if (rc) {
 		return rc;
 	}
+
+	rc = nvs_gc_copy(fs, &gc_addr, stop_addr, UINT32_MAX);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_gc_finish(fs, sec_addr);
+}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+/* Complete whatever the background gc left to do before the sector after the
+ * write sector can be written to, or before foreground writes may continue in
+ * the write sector.
+ */
+static int nvs_gc_sync(struct nvs_fs *fs, bool need_erase)
+{
+	int rc;
+
+	if (fs->gc_state == NVS_GC_STATE_COPY) {
+#ifdef CONFIG_NVS_GC_STATS
+		fs->gc_stats.sync_copies++;
+#endif
+		/* On error the gc stays pending, to be resumed by the next
+		 * writer or by the background.
+		 */
+		rc = nvs_gc_copy(fs, &fs->gc_addr, fs->gc_stop_addr, UINT32_MAX);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc_finish(fs, fs->gc_sec_addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	if (need_erase && (fs->gc_state == NVS_GC_STATE_ERASE)) {
+#ifdef CONFIG_NVS_GC_STATS
+		fs->gc_stats.sync_erases++;
+#endif
+		rc = nvs_flash_erase_sector(fs, fs->gc_sec_addr);
+		if (rc) {
+			return rc;
+		}
+		fs->gc_state = NVS_GC_STATE_IDLE;
+	}
+
 	return 0;
 }
 
+/* Close the write sector ahead of time when its free space drops below the
+ * threshold, unless it was only just filled by gc.
+ */
+static bool nvs_gc_preempt_needed(struct nvs_fs *fs)
+{
+	uint32_t threshold;
+
+	threshold = fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100U;
+
+	return (fs->gc_state == NVS_GC_STATE_IDLE) && !fs->gc_fresh &&
+	       ((fs->ate_wra - fs->data_wra) < threshold);
+}
+
+/* The sector waiting for its erase only holds entries that gc has already
+ * copied into the write sector.
+ */
+static bool nvs_gc_erase_pending(struct nvs_fs *fs, uint32_t addr)
+{
+	return (fs->gc_state == NVS_GC_STATE_ERASE) &&
+	       ((addr & ADDR_SECT_MASK) == fs->gc_sec_addr);
+}
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc = 0;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready) {
+		goto end;
+	}
+
+	switch (fs->gc_state) {
+	case NVS_GC_STATE_IDLE:
+		if (!nvs_gc_preempt_needed(fs)) {
+			goto end;
+		}
+
+		LOG_DBG("Starting background gc");
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			break;
+		}
+
+		rc = nvs_gc_start(fs, &fs->gc_sec_addr, &fs->gc_addr, &fs->gc_stop_addr);
+		if (rc) {
+			break;
+		}
+		fs->gc_state = NVS_GC_STATE_COPY;
+		break;
+	case NVS_GC_STATE_COPY:
+		rc = nvs_gc_copy(fs, &fs->gc_addr, fs->gc_stop_addr,
+				 CONFIG_NVS_BACKGROUND_GC_STEP_ATES);
+		if (rc == 0) {
+			rc = nvs_gc_finish(fs, fs->gc_sec_addr);
+		} else if (rc > 0) {
+			rc = 0;
+		}
+		break;
+	case NVS_GC_STATE_ERASE:
+		rc = nvs_flash_erase_sector(fs, fs->gc_sec_addr);
+		if (rc) {
+			break;
+		}
+		fs->gc_state = NVS_GC_STATE_IDLE;
+		break;
+	default:
+		break;
+	}
+
+	if (rc) {
+		/* Leave the work to the next write, which reports the error */
+		LOG_ERR("Background gc failed: %d", rc);
+		goto end;
+	}
+
+	if (fs->gc_state != NVS_GC_STATE_IDLE) {
+		k_work_submit(&fs->gc_work);
+	}
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -721,6 +1118,17 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_ID_INDEX
+	/* Until the index is rebuilt at the end of startup, a restarted gc
+	 * has to walk the full fs for every ID.
+	 */
+	nvs_id_index_reset(fs, false);
+#endif
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	fs->gc_state = NVS_GC_STATE_IDLE;
+	fs->gc_fresh = false;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -914,6 +1322,10 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	if (!rc) {
+		rc = nvs_id_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -931,12 +1343,26 @@ int nvs_clear(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr;
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work_sync sync;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
 		return -EACCES;
 	}
 
+	/* nvs needs to be reinitialized after clearing */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->ready = false;
+	k_mutex_unlock(&fs->nvs_lock);
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* Don't let the background gc write to the sectors being erased */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	fs->gc_state = NVS_GC_STATE_IDLE;
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -945,9 +1371,6 @@ int nvs_clear(struct nvs_fs *fs)
 		}
 	}
 
-	/* nvs needs to be reinitialized after clearing */
-	fs->ready = false;
-
 	return 0;
 }
 
@@ -958,6 +1381,19 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* The background gc only runs on a mounted file system */
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* Remount: stop background gc of the previous mount first */
+		fs->ready = false;
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1007,6 +1443,12 @@ int nvs_mount(struct nvs_fs *fs)
 		(fs->data_wra >> ADDR_SECT_SHIFT),
 		(fs->data_wra & ADDR_OFFS_MASK));
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (fs->gc_state != NVS_GC_STATE_IDLE) {
+		k_work_submit(&fs->gc_work);
+	}
+#endif
+
 	return 0;
 }
 
@@ -1018,6 +1460,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
 	bool prev_found = false;
+#ifdef CONFIG_NVS_GC_STATS
+	uint32_t start, write_us;
+#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1040,6 +1485,12 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	wlk_addr = nvs_id_index_get(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
 	}
@@ -1063,7 +1514,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_ID_INDEX)
 no_cached_entry:
 #endif
 
@@ -1101,8 +1552,19 @@ no_cached_entry:
 		required_space = data_size + ate_size;
 	}
 
+#ifdef CONFIG_NVS_GC_STATS
+	start = k_cycle_get_32();
+#endif
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* Nothing can be written while gc is still moving entries */
+	rc = nvs_gc_sync(fs, false);
+	if (rc) {
+		goto end;
+	}
+#endif
+
 	gc_count = 0;
 	while (1) {
 		if (gc_count == fs->sector_count) {
@@ -1119,9 +1581,19 @@ no_cached_entry:
 			if (rc) {
 				goto end;
 			}
+#ifdef CONFIG_NVS_BACKGROUND_GC
+			fs->gc_fresh = false;
+#endif
 			break;
 		}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* The sector after the write sector is about to be opened */
+		rc = nvs_gc_sync(fs, true);
+		if (rc) {
+			goto end;
+		}
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
@@ -1135,7 +1607,19 @@ no_cached_entry:
 		gc_count++;
 	}
 	rc = len;
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if ((fs->gc_state != NVS_GC_STATE_IDLE) || nvs_gc_preempt_needed(fs)) {
+		k_work_submit(&fs->gc_work);
+	}
+#endif
 end:
+#ifdef CONFIG_NVS_GC_STATS
+	write_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+	if (write_us > fs->gc_stats.max_write_us) {
+		fs->gc_stats.max_write_us = write_us;
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -1170,6 +1654,13 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	wlk_addr = nvs_id_index_get(fs, id);
+
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
@@ -1181,6 +1672,12 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	while (cnt_his <= cnt) {
 		rd_addr = wlk_addr;
+#ifdef CONFIG_NVS_BACKGROUND_GC
+		/* Older entries are duplicates of the ones gc has copied */
+		if (nvs_gc_erase_pending(fs, rd_addr)) {
+			return -ENOENT;
+		}
+#endif
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
 			goto err;
@@ -1273,3 +1770,44 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+int nvs_gc_wait(struct nvs_fs *fs)
+{
+	struct k_work_sync sync;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* Every step of the background gc submits the next one */
+	while (k_work_flush(&fs->gc_work, &sync)) {
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
+#ifdef CONFIG_NVS_GC_STATS
+int nvs_gc_stats_get(struct nvs_fs *fs, struct nvs_gc_stats *stats)
+{
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	*stats = fs->gc_stats;
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return 0;
+}
+
+void nvs_gc_stats_reset(struct nvs_fs *fs)
+{
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	memset(&fs->gc_stats, 0, sizeof(fs->gc_stats));
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif /* CONFIG_NVS_GC_STATS */
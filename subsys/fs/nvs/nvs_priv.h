@@ -30,6 +30,14 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/* gc address once all ATEs of the gc'ed sector have been processed */
+#define NVS_GC_NO_ADDR 0xFFFFFFFF
+
+/* Background garbage collection states */
+#define NVS_GC_STATE_IDLE  0 /* nothing pending */
+#define NVS_GC_STATE_COPY  1 /* moving live entries out of gc_sec_addr */
+#define NVS_GC_STATE_ERASE 2 /* gc done, gc_sec_addr still to be erased */
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
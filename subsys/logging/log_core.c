@@ -119,16 +119,33 @@ static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_CPU_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+
+/* log_buffer is used by CPU 0, the remaining CPUs get an entry of these
+ * arrays. Being registered in the same sections as dedicated link buffers
+ * makes the processing merge all of them by timestamp.
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr_cpu, LOG_CPU_BUFFERS - 1);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_buffer_cpu, LOG_CPU_BUFFERS - 1);
+#else
+#define LOG_CPU_BUFFERS 1
+#endif
+
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
 	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
 
+/* Words of buf32 used by each CPU buffer. */
+#define LOG_CPU_BUFFER_WLEN (ARRAY_SIZE(buf32) / LOG_CPU_BUFFERS)
+
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.size = LOG_CPU_BUFFER_WLEN,
 	.notify_drop = z_log_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -620,10 +637,48 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+static inline struct mpsc_pbuf_buffer *cpu_buffer_get(unsigned int idx)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (idx > 0) {
+		return &log_buffer_cpu[idx - 1];
+	}
+#endif
+	return &log_buffer;
+}
+
+/* Buffer of the CPU the caller is running on. Thread might migrate right
+ * after the check which is harmless, buffers still accept messages from any
+ * context.
+ */
+static inline struct mpsc_pbuf_buffer *local_buffer_get(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return cpu_buffer_get(arch_curr_cpu()->id);
+#else
+	return &log_buffer;
+#endif
+}
+
+/* Buffer from which given message was allocated. */
+static inline struct mpsc_pbuf_buffer *msg_buffer_get(const struct log_msg *msg)
+{
+#if defined(CONFIG_LOG_PER_CPU_BUFFERS) && defined(CONFIG_MPSC_PBUF)
+	return cpu_buffer_get(((const uint32_t *)msg - buf32) / LOG_CPU_BUFFER_WLEN);
+#else
+	return &log_buffer;
+#endif
+}
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = &buf32[i * LOG_CPU_BUFFER_WLEN];
+		mpsc_pbuf_init(cpu_buffer_get(i), &config);
+	}
 	curr_log_buffer = &log_buffer;
 #endif
 }
@@ -643,7 +698,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer_get(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -665,7 +720,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer_get(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -752,7 +807,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -787,7 +843,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -867,7 +924,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(cpu_buffer_get(i), &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
 
 	return 0;
 }
@@ -880,7 +946,20 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	*max = 0;
+
+	/* Sum of per buffer peaks, an upper bound of the peak total usage. */
+	for (unsigned int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t buf_max;
+		int err = mpsc_pbuf_get_max_utilization(cpu_buffer_get(i), &buf_max);
+
+		if (err < 0) {
+			return err;
+		}
+		*max += buf_max;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -20,6 +20,8 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include <zephyr/net/buf.h>
 
+#include <percpu_cache.h>
+
 #if defined(CONFIG_NET_BUF_LOG)
 #define NET_BUF_DBG(fmt, ...) LOG_DBG("(%p) " fmt, k_current_get(), \
 				      ##__VA_ARGS__)
@@ -222,22 +224,93 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
-#if defined(CONFIG_NET_BUF_LOG)
-struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
-					k_timeout_t timeout, const char *func,
-					int line)
-#else
-struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
-				  k_timeout_t timeout)
-#endif
+#if defined(CONFIG_NET_BUF_POOL_STATS)
+static void pool_stats_update(struct net_buf_pool *pool, struct net_buf *buf,
+			      bool cache_hit, uint32_t start)
 {
-	k_timepoint_t end = sys_timepoint_calc(timeout);
-	struct net_buf *buf;
+	uint32_t cycles = k_cycle_get_32() - start;
+	struct net_buf_pool_cpu *cpu;
 	k_spinlock_key_t key;
 
-	__ASSERT_NO_MSG(pool);
+	cpu = Z_PERCPU_CACHE_LOCK(pool->cpu, &key);
 
-	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
+	if (buf) {
+		cpu->stats.allocs++;
+		cpu->stats.cache_hits += cache_hit ? 1U : 0U;
+	} else {
+		cpu->stats.failures++;
+	}
+
+	cpu->stats.alloc_cycles += cycles;
+	cpu->stats.max_alloc_cycles = MAX(cpu->stats.max_alloc_cycles, cycles);
+
+	k_spin_unlock(&cpu->lock, key);
+}
+
+static void pool_stats_avail(struct net_buf_pool *pool, atomic_val_t avail)
+{
+	atomic_val_t min = atomic_get(&pool->min_avail);
+
+	while (avail < min && !atomic_cas(&pool->min_avail, min, avail)) {
+		min = atomic_get(&pool->min_avail);
+	}
+}
+
+void net_buf_pool_stats_get(struct net_buf_pool *pool,
+			    struct net_buf_pool_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < ARRAY_SIZE(pool->cpu); i++) {
+		struct net_buf_pool_cpu *cpu = &pool->cpu[i];
+		k_spinlock_key_t key = k_spin_lock(&cpu->lock);
+
+		stats->allocs += cpu->stats.allocs;
+		stats->failures += cpu->stats.failures;
+		stats->cache_hits += cpu->stats.cache_hits;
+		stats->alloc_cycles += cpu->stats.alloc_cycles;
+		stats->max_alloc_cycles = MAX(stats->max_alloc_cycles,
+					      cpu->stats.max_alloc_cycles);
+
+		k_spin_unlock(&cpu->lock, key);
+	}
+
+	stats->min_avail = atomic_get(&pool->min_avail);
+}
+
+void net_buf_pool_stats_reset(struct net_buf_pool *pool)
+{
+	for (int i = 0; i < ARRAY_SIZE(pool->cpu); i++) {
+		struct net_buf_pool_cpu *cpu = &pool->cpu[i];
+		k_spinlock_key_t key = k_spin_lock(&cpu->lock);
+
+		memset(&cpu->stats, 0, sizeof(cpu->stats));
+
+		k_spin_unlock(&cpu->lock, key);
+	}
+
+	atomic_set(&pool->min_avail, atomic_get(&pool->avail_count));
+}
+#else
+static inline void pool_stats_update(struct net_buf_pool *pool,
+				     struct net_buf *buf, bool cache_hit,
+				     uint32_t start)
+{
+}
+
+static inline void pool_stats_avail(struct net_buf_pool *pool,
+				    atomic_val_t avail)
+{
+}
+#endif /* CONFIG_NET_BUF_POOL_STATS */
+
+/* Get a free buffer without waiting, from the pool's free list or from the
+ * buffers which were never used yet.
+ */
+static struct net_buf *pool_get_free(struct net_buf_pool *pool)
+{
+	struct net_buf *buf;
+	k_spinlock_key_t key;
 
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
@@ -258,19 +331,180 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 			buf = k_lifo_get(&pool->free, K_NO_WAIT);
 			if (buf) {
 				k_spin_unlock(&pool->lock, key);
-				goto success;
+				return buf;
 			}
 		}
 
 		uninit_count = pool->uninit_count--;
 		k_spin_unlock(&pool->lock, key);
 
-		buf = pool_get_uninit(pool, uninit_count);
-		goto success;
+		return pool_get_uninit(pool, uninit_count);
 	}
 
 	k_spin_unlock(&pool->lock, key);
 
+	return k_lifo_get(&pool->free, K_NO_WAIT);
+}
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+#define CACHE_BATCH (CONFIG_NET_BUF_POOL_CPU_CACHE_SIZE / 2)
+
+static struct net_buf *pool_cache_get(struct net_buf_pool *pool)
+{
+	struct net_buf *buf = NULL;
+	struct net_buf_pool_cpu *cpu;
+	k_spinlock_key_t key;
+
+	cpu = Z_PERCPU_CACHE_LOCK(pool->cpu, &key);
+
+	if (cpu->cache_count > 0) {
+		buf = cpu->cache[--cpu->cache_count];
+	}
+
+	k_spin_unlock(&cpu->lock, key);
+
+	return buf;
+}
+
+/* Called after a cache miss, so that the next allocations on this CPU
+ * do not need the free list.
+ */
+static void pool_cache_refill(struct net_buf_pool *pool)
+{
+	struct net_buf *bufs[CACHE_BATCH];
+	struct net_buf_pool_cpu *cpu;
+	k_spinlock_key_t key;
+	int n;
+
+	if (z_percpu_cache_has_waiters(&pool->waiters)) {
+		return;
+	}
+
+	for (n = 0; n < ARRAY_SIZE(bufs); n++) {
+		bufs[n] = pool_get_free(pool);
+		if (!bufs[n]) {
+			break;
+		}
+	}
+
+	cpu = Z_PERCPU_CACHE_LOCK(pool->cpu, &key);
+
+	while (n > 0 && cpu->cache_count < ARRAY_SIZE(cpu->cache) &&
+	       !z_percpu_cache_has_waiters(&pool->waiters)) {
+		cpu->cache[cpu->cache_count++] = bufs[--n];
+	}
+
+	k_spin_unlock(&cpu->lock, key);
+
+	/* Someone started waiting, or this thread migrated to a CPU whose
+	 * cache filled up meanwhile.
+	 */
+	while (n > 0) {
+		k_lifo_put(&pool->free, bufs[--n]);
+	}
+}
+
+/* Move the buffers cached by a CPU to the free list */
+static void pool_cache_flush(void *obj, unsigned int cpu_id)
+{
+	struct net_buf_pool *pool = obj;
+	struct net_buf_pool_cpu *cpu = &pool->cpu[cpu_id];
+
+	while (cpu->cache_count > 0) {
+		k_lifo_put(&pool->free, cpu->cache[--cpu->cache_count]);
+	}
+}
+
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_pool_cpu *cpu;
+	k_spinlock_key_t key;
+
+	cpu = Z_PERCPU_CACHE_LOCK(pool->cpu, &key);
+
+	/* Waiters are only woken up by the free list */
+	if (z_percpu_cache_has_waiters(&pool->waiters)) {
+		k_spin_unlock(&cpu->lock, key);
+		k_lifo_put(&pool->free, buf);
+		return;
+	}
+
+	if (cpu->cache_count == ARRAY_SIZE(cpu->cache)) {
+		/* Give the least recently freed half back */
+		for (int i = 0; i < CACHE_BATCH; i++) {
+			k_lifo_put(&pool->free, cpu->cache[i]);
+		}
+
+		cpu->cache_count -= CACHE_BATCH;
+		memmove(&cpu->cache[0], &cpu->cache[CACHE_BATCH],
+			cpu->cache_count * sizeof(cpu->cache[0]));
+	}
+
+	cpu->cache[cpu->cache_count++] = buf;
+
+	k_spin_unlock(&cpu->lock, key);
+}
+
+static void pool_wait_begin(struct net_buf_pool *pool)
+{
+	Z_PERCPU_CACHE_WAIT_BEGIN(&pool->waiters, pool->cpu, pool_cache_flush, pool);
+}
+
+static void pool_wait_end(struct net_buf_pool *pool)
+{
+	z_percpu_cache_wait_end(&pool->waiters);
+}
+#else
+static inline struct net_buf *pool_cache_get(struct net_buf_pool *pool)
+{
+	return NULL;
+}
+
+static inline void pool_cache_refill(struct net_buf_pool *pool)
+{
+}
+
+static inline void pool_wait_begin(struct net_buf_pool *pool)
+{
+}
+
+static inline void pool_wait_end(struct net_buf_pool *pool)
+{
+}
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+
+#if defined(CONFIG_NET_BUF_LOG)
+struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
+					k_timeout_t timeout, const char *func,
+					int line)
+#else
+struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
+				  k_timeout_t timeout)
+#endif
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	uint32_t start = IS_ENABLED(CONFIG_NET_BUF_POOL_STATS) ? k_cycle_get_32() : 0U;
+	bool cache_hit = false;
+	struct net_buf *buf;
+
+	__ASSERT_NO_MSG(pool);
+
+	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
+
+	buf = pool_cache_get(pool);
+	if (buf) {
+		cache_hit = true;
+		goto success;
+	}
+
+	buf = pool_get_free(pool);
+	if (buf) {
+		pool_cache_refill(pool);
+		goto success;
+	}
+
+	pool_wait_begin(pool);
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -300,8 +534,12 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #else
 	buf = k_lifo_get(&pool->free, timeout);
 #endif
+
+	pool_wait_end(pool);
+
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
+		pool_stats_update(pool, NULL, false, start);
 		return NULL;
 	}
 
@@ -318,6 +556,7 @@ success:
 			NET_BUF_ERR("%s():%d: Failed to allocate data",
 				    func, line);
 			net_buf_destroy(buf);
+			pool_stats_update(pool, NULL, false, start);
 			return NULL;
 		}
 
@@ -335,9 +574,11 @@ success:
 	net_buf_reset(buf);
 
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
+	pool_stats_avail(pool, atomic_dec(&pool->avail_count) - 1);
 	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
 #endif
+	pool_stats_update(pool, buf, cache_hit, start);
+
 	return buf;
 }
 
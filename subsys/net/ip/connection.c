@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_function.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -116,6 +117,166 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/** All the ranked specifiers set, i.e. connection has the highest rank */
+#define NET_CONN_FULLY_SPEC		(NET_CONN_REMOTE_PORT_SPEC | NET_CONN_LOCAL_PORT_SPEC | \
+					 NET_CONN_REMOTE_ADDR_SPEC | NET_CONN_LOCAL_ADDR_SPEC)
+
+/* Fully specified TCP and UDP connections are put in a hash bucket, all
+ * the others in the wildcard list. Both are protected by conn_lock.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+static uint32_t conn_addr_fold(uint8_t family, const uint8_t *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		return UNALIGNED_GET((uint32_t *)&addr[0]) ^
+		       UNALIGNED_GET((uint32_t *)&addr[4]) ^
+		       UNALIGNED_GET((uint32_t *)&addr[8]) ^
+		       UNALIGNED_GET((uint32_t *)&addr[12]);
+	}
+
+	return UNALIGNED_GET((uint32_t *)addr);
+}
+
+static sys_slist_t *conn_hash_bucket(uint16_t proto, uint8_t family,
+				     const uint8_t *remote_addr,
+				     uint16_t remote_port,
+				     const uint8_t *local_addr,
+				     uint16_t local_port)
+{
+	struct {
+		uint32_t remote_addr;
+		uint32_t local_addr;
+		uint16_t remote_port;
+		uint16_t local_port;
+		uint16_t proto;
+		uint16_t family;
+	} key = {
+		.remote_addr = conn_addr_fold(family, remote_addr),
+		.local_addr = conn_addr_fold(family, local_addr),
+		.remote_port = remote_port,
+		.local_port = local_port,
+		.proto = proto,
+		.family = family,
+	};
+
+	return &conn_hash[sys_hash32_murmur3(&key, sizeof(key)) %
+			  CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static const uint8_t *conn_addr_get(struct net_conn *conn,
+				    struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6) {
+		return net_sin6(addr)->sin6_addr.s6_addr;
+	}
+
+	return net_sin(addr)->sin_addr.s4_addr;
+}
+
+static sys_slist_t *conn_list_get(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_FULLY_SPEC) != NET_CONN_FULLY_SPEC ||
+	    (conn->proto != IPPROTO_TCP && conn->proto != IPPROTO_UDP) ||
+	    (conn->family != AF_INET && conn->family != AF_INET6) ||
+	    conn->remote_addr.sa_family != conn->family ||
+	    conn->local_addr.sa_family != conn->family) {
+		return &conn_wildcard;
+	}
+
+	return conn_hash_bucket(conn->proto, conn->family,
+				conn_addr_get(conn, &conn->remote_addr),
+				net_sin(&conn->remote_addr)->sin_port,
+				conn_addr_get(conn, &conn->local_addr),
+				net_sin(&conn->local_addr)->sin_port);
+}
+
+/* Must be called with conn_lock held */
+static inline void conn_hash_add(struct net_conn *conn)
+{
+	sys_slist_prepend(conn_list_get(conn), &conn->hash_node);
+}
+
+/* Must be called with conn_lock held */
+static inline void conn_hash_remove(struct net_conn *conn)
+{
+	sys_slist_find_and_remove(conn_list_get(conn), &conn->hash_node);
+}
+
+/* Find a fully specified connection matching a unicast TCP or UDP packet.
+ * Must be called with conn_lock held.
+ */
+static struct net_conn *conn_hash_lookup(struct net_pkt *pkt,
+					 union net_ip_header *ip_hdr,
+					 uint8_t proto,
+					 uint16_t src_port,
+					 uint16_t dst_port)
+{
+	uint8_t family = net_pkt_family(pkt);
+	const uint8_t *src, *dst;
+	struct net_conn *conn;
+	sys_slist_t *bucket;
+	size_t addr_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+		addr_len = sizeof(struct in6_addr);
+	} else {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+		addr_len = sizeof(struct in_addr);
+	}
+
+	bucket = conn_hash_bucket(proto, family, src, src_port, dst, dst_port);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, hash_node) {
+		if (conn->proto != proto || conn->family != family ||
+		    net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port ||
+		    memcmp(conn_addr_get(conn, &conn->remote_addr), src, addr_len) ||
+		    memcmp(conn_addr_get(conn, &conn->local_addr), dst, addr_len)) {
+			continue;
+		}
+
+		if (conn->context != NULL &&
+		    net_context_is_bound_to_iface(conn->context) &&
+		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+			continue; /* wrong interface */
+		}
+
+		return conn;
+	}
+
+	return NULL;
+}
+#else
+static inline void conn_hash_add(struct net_conn *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static inline void conn_hash_remove(struct net_conn *conn)
+{
+	ARG_UNUSED(conn);
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+static inline struct net_conn *conn_from_node(sys_snode_t *node, bool wildcard)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	if (wildcard) {
+		return CONTAINER_OF(node, struct net_conn, hash_node);
+	}
+#else
+	ARG_UNUSED(wildcard);
+#endif
+
+	return CONTAINER_OF(node, struct net_conn, node);
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +302,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -450,6 +612,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,7 +639,12 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The new remote end might move the connection to another list */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -676,7 +844,10 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
+	sys_slist_t *conn_list = &conn_used;
+	bool wildcard_only = false;
 	struct net_conn *conn;
+	sys_snode_t *node;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
 
@@ -698,7 +869,26 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+#if defined(CONFIG_NET_CONN_HASH)
+	/* A unicast TCP or UDP packet goes to a fully specified connection
+	 * if there is one, as nothing can rank higher. Otherwise only the
+	 * connections which are not in the hash table need to be checked.
+	 */
+	if ((pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_TCP || proto == IPPROTO_UDP) && !is_mcast_pkt) {
+		best_match = conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+		if (best_match != NULL) {
+			goto found;
+		}
+
+		conn_list = &conn_wildcard;
+		wildcard_only = true;
+	}
+#endif
+
+	SYS_SLIST_FOR_EACH_NODE(conn_list, node) {
+		conn = conn_from_node(node, wildcard_only);
+
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -866,6 +1056,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+#if defined(CONFIG_NET_CONN_HASH)
+found:
+#endif
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -953,6 +1146,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
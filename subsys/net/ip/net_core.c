@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/toolchain.h>
 #include <zephyr/linker/sections.h>
+#include <zephyr/sys/hash_function.h>
 #include <string.h>
 #include <errno.h>
 
@@ -374,6 +375,221 @@ drop:
 	return ret;
 }
 
+#if defined(CONFIG_NET_GSO) || defined(CONFIG_NET_GRO)
+/* TCP header flags looked at when splitting or coalescing segments */
+#define TCP_FLAG_FIN BIT(0)
+#define TCP_FLAG_PSH BIT(3)
+#define TCP_FLAG_ACK BIT(4)
+#endif
+
+#if defined(CONFIG_NET_GSO)
+#define GSO_ALLOC_TIMEOUT K_MSEC(100)
+
+/* A GSO packet delivered back to us is not segmented, it only needs the
+ * checksum which was left for the segments.
+ */
+static int gso_finalize(struct net_pkt *pkt)
+{
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_set_gso_size(pkt, 0);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt));
+	if (ret == 0) {
+		ret = net_tcp_finalize(pkt, true);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return ret;
+}
+
+/* Append to seg references to the len bytes of pkt data from offset on.
+ * The buffers are cloned, which only copies their data if their pool
+ * cannot share it.
+ */
+static int gso_ref_data(struct net_pkt *seg, struct net_pkt *pkt, size_t offset,
+			uint16_t len)
+{
+	struct net_buf *frag, *clone;
+	uint16_t chunk;
+
+	for (frag = pkt->buffer; frag && len > 0; frag = frag->frags) {
+		if (offset >= frag->len) {
+			offset -= frag->len;
+			continue;
+		}
+
+		clone = net_buf_clone(frag, GSO_ALLOC_TIMEOUT);
+		if (!clone) {
+			return -ENOMEM;
+		}
+
+		chunk = MIN(frag->len - offset, len);
+		net_buf_pull(clone, offset);
+		net_buf_remove_mem(clone, clone->len - chunk);
+		net_pkt_append_buffer(seg, clone);
+
+		offset = 0;
+		len -= chunk;
+	}
+
+	return len > 0 ? -EINVAL : 0;
+}
+
+/* Build the segment holding len bytes of data from offset on. Only the
+ * headers are copied, the segment refers to the data of the GSO packet.
+ */
+static struct net_pkt *gso_segment(struct net_pkt *pkt, uint16_t hdr_len,
+				   size_t offset, uint16_t len, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint16_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(iface, hdr_len, net_pkt_family(pkt),
+					0, GSO_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len)) {
+		goto fail;
+	}
+
+	/* Drop the unused header room, the data must follow the headers */
+	net_pkt_trim_buffer(seg);
+
+	if (gso_ref_data(seg, pkt, hdr_len + offset, len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = NET_IPV4_HDR(seg);
+		uint16_t ip_total = htons(hdr_len + len);
+
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+
+		/* Only the length differs from the header of the GSO packet */
+		if (net_if_need_calc_tx_checksum(iface)) {
+			ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum,
+							       ipv4_hdr->len, ip_total);
+		}
+
+		ipv4_hdr->len = ip_total;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+
+		NET_IPV6_HDR(seg)->len = htons(hdr_len + len - sizeof(struct net_ipv6_hdr));
+	}
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	if (!last) {
+		tcp_hdr->flags &= ~(TCP_FLAG_FIN | TCP_FLAG_PSH);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_skip(seg, ip_len);
+
+	if (net_tcp_finalize(seg, false) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, false);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+	return NULL;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint16_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t payload_len;
+	uint16_t hdr_len;
+	int sent = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	payload_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < payload_len; offset += mss) {
+		uint16_t len = MIN(mss, payload_len - offset);
+		struct net_pkt *seg;
+		int ret;
+
+		seg = gso_segment(pkt, hdr_len, offset, len, offset + len == payload_len);
+		if (!seg) {
+			NET_DBG("Cannot segment pkt %p at %zu", pkt, offset);
+			return -ENOMEM;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			return ret;
+		}
+
+		sent += ret;
+	}
+
+	NET_DBG("Sent pkt %p as %zu segments", pkt, DIV_ROUND_UP(payload_len, mss));
+
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+#endif /* CONFIG_NET_GSO */
+
 /* Called when data needs to be sent to network */
 int net_send_data(struct net_pkt *pkt)
 {
@@ -407,6 +623,16 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+#if defined(CONFIG_NET_GSO)
+		if (net_pkt_gso_size(pkt) > 0U) {
+			status = gso_finalize(pkt);
+			if (status < 0) {
+				return status;
+			}
+		}
+#endif
+
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -429,6 +655,360 @@ int net_send_data(struct net_pkt *pkt)
 	return 0;
 }
 
+#if defined(CONFIG_NET_GRO) || defined(CONFIG_NET_RPS)
+/* Length of the link layer header of a received IP packet, which is still
+ * in front of the network header when it is queued.
+ */
+static int rx_l2_hdr_len(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr *eth_hdr = NET_ETH_HDR(pkt);
+
+		if (pkt->buffer->len < sizeof(struct net_eth_hdr) ||
+		    (eth_hdr->type != htons(NET_ETH_PTYPE_IP) &&
+		     eth_hdr->type != htons(NET_ETH_PTYPE_IPV6))) {
+			return -ENOTSUP;
+		}
+
+		return sizeof(struct net_eth_hdr);
+	}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return 0;
+	}
+#endif
+
+	return -ENOTSUP;
+}
+#endif
+
+#if defined(CONFIG_NET_RPS)
+/* Hash the addresses and the ports of a received packet, so that all the
+ * packets of a flow are processed by the same RX queue.
+ */
+static uint32_t rps_hash(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	uint8_t key[2 * sizeof(struct in6_addr) + 2 * sizeof(uint16_t)];
+	size_t key_len, ip_len;
+	uint8_t proto;
+	uint8_t *ip;
+	int l2_len;
+
+	l2_len = rx_l2_hdr_len(pkt);
+	if (l2_len < 0) {
+		return 0U;
+	}
+
+	ip = buf->data + l2_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && buf->len >= l2_len + sizeof(struct net_ipv4_hdr) &&
+	    (ip[0] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)ip;
+
+		key_len = 2 * sizeof(struct in_addr);
+		memcpy(key, ipv4_hdr->src, key_len);
+
+		/* Only the first fragment has the ports */
+		ip_len = (ipv4_hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+		proto = (sys_get_be16(ipv4_hdr->offset) &
+			 (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) == 0U ?
+			ipv4_hdr->proto : 0U;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   buf->len >= l2_len + sizeof(struct net_ipv6_hdr) &&
+		   (ip[0] & 0xf0) == 0x60) {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)ip;
+
+		key_len = 2 * sizeof(struct in6_addr);
+		memcpy(key, ipv6_hdr->src, key_len);
+
+		ip_len = sizeof(struct net_ipv6_hdr);
+		proto = ipv6_hdr->nexthdr;
+	} else {
+		return 0U;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    buf->len >= l2_len + ip_len + 2 * sizeof(uint16_t)) {
+		memcpy(key + key_len, ip + ip_len, 2 * sizeof(uint16_t));
+		key_len += 2 * sizeof(uint16_t);
+	}
+
+	return sys_hash32_murmur3(key, key_len);
+}
+#endif /* CONFIG_NET_RPS */
+
+#if defined(CONFIG_NET_GRO)
+
+/* Locate the headers of a TCP segment that can be coalesced with others,
+ * i.e. one carrying data and no other flag than ACK and PSH.
+ */
+static int gro_parse(struct net_pkt *pkt, struct net_gro_hdr *hdr)
+{
+	struct net_buf *buf = pkt->buffer;
+	uint16_t ip_len, tcp_len, total_len;
+	int l2_len;
+
+	l2_len = rx_l2_hdr_len(pkt);
+	if (l2_len < 0) {
+		return l2_len;
+	}
+
+	hdr->l2_len = l2_len;
+	hdr->ip = buf->data + l2_len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && buf->len >= l2_len + sizeof(struct net_ipv4_hdr) &&
+	    (hdr->ip[0] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr->ip;
+
+		if (ipv4_hdr->vhl != 0x45 || ipv4_hdr->proto != IPPROTO_TCP ||
+		    (sys_get_be16(ipv4_hdr->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			return -ENOTSUP;
+		}
+
+		ip_len = sizeof(struct net_ipv4_hdr);
+		total_len = ntohs(ipv4_hdr->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   buf->len >= l2_len + sizeof(struct net_ipv6_hdr) &&
+		   (hdr->ip[0] & 0xf0) == 0x60) {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr->ip;
+
+		if (ipv6_hdr->nexthdr != IPPROTO_TCP) {
+			return -ENOTSUP;
+		}
+
+		ip_len = sizeof(struct net_ipv6_hdr);
+		total_len = ip_len + ntohs(ipv6_hdr->len);
+	} else {
+		return -ENOTSUP;
+	}
+
+	if (buf->len < l2_len + ip_len + sizeof(struct net_tcp_hdr)) {
+		return -ENOTSUP;
+	}
+
+	hdr->tcp = (struct net_tcp_hdr *)(hdr->ip + ip_len);
+	tcp_len = (hdr->tcp->offset >> 4) * 4U;
+
+	if (tcp_len < sizeof(struct net_tcp_hdr) || buf->len < l2_len + ip_len + tcp_len ||
+	    total_len <= ip_len + tcp_len || l2_len + total_len != net_pkt_get_len(pkt) ||
+	    (hdr->tcp->flags & ~TCP_FLAG_PSH) != TCP_FLAG_ACK) {
+		return -ENOTSUP;
+	}
+
+	hdr->tcp_len = tcp_len;
+	hdr->hdr_len = l2_len + ip_len + tcp_len;
+	hdr->payload_len = total_len - ip_len - tcp_len;
+
+	return 0;
+}
+
+static uint16_t gro_chksum_add(uint16_t a, uint16_t b)
+{
+	uint32_t sum = (uint32_t)a + b;
+
+	return (sum & 0xffff) + (sum >> 16);
+}
+
+/* Sum of the TCP pseudo header and header of a segment, including its
+ * checksum field.
+ */
+static uint16_t gro_hdr_chksum(struct net_gro_hdr *hdr, uint16_t payload_len)
+{
+	uint16_t sum = IPPROTO_TCP + hdr->tcp_len + payload_len;
+
+	if ((hdr->ip[0] & 0xf0) == 0x40) {
+		sum = calc_chksum(sum, ((struct net_ipv4_hdr *)hdr->ip)->src,
+				  2 * sizeof(struct in_addr));
+	} else {
+		sum = calc_chksum(sum, ((struct net_ipv6_hdr *)hdr->ip)->src,
+				  2 * sizeof(struct in6_addr));
+	}
+
+	return calc_chksum(sum, (uint8_t *)hdr->tcp, hdr->tcp_len);
+}
+
+/* Sum of the payload, assuming the checksum of the segment is right. The
+ * checksum of the coalesced packet is made of these, so a corrupted segment
+ * still gets the whole packet dropped by TCP.
+ */
+static uint16_t gro_payload_chksum(struct net_gro_hdr *hdr)
+{
+	return ~gro_hdr_chksum(hdr, hdr->payload_len);
+}
+
+/* Is the segment in pkt the continuation of the flow in gro */
+static bool gro_match(struct net_gro *gro, struct net_pkt *pkt, struct net_gro_hdr *hdr)
+{
+	struct net_gro_hdr *first = &gro->hdr;
+
+	if (net_pkt_iface(pkt) != net_pkt_iface(gro->pkt) ||
+	    hdr->hdr_len != first->hdr_len || hdr->ip[0] != first->ip[0] ||
+	    hdr->payload_len > first->payload_len ||
+	    gro->len + hdr->payload_len > CONFIG_NET_GRO_MAX_SIZE ||
+	    sys_get_be32(hdr->tcp->seq) != gro->next_seq) {
+		return false;
+	}
+
+	/* Link layer header */
+	if (memcmp(pkt->buffer->data, gro->pkt->buffer->data, hdr->l2_len) != 0) {
+		return false;
+	}
+
+	if ((hdr->ip[0] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *a = (struct net_ipv4_hdr *)first->ip;
+		struct net_ipv4_hdr *b = (struct net_ipv4_hdr *)hdr->ip;
+
+		if (a->tos != b->tos || a->ttl != b->ttl ||
+		    memcmp(a->src, b->src, 2 * sizeof(struct in_addr)) != 0) {
+			return false;
+		}
+
+		if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+		    calc_chksum(0, hdr->ip, sizeof(struct net_ipv4_hdr)) != 0xffff) {
+			return false;
+		}
+	} else {
+		struct net_ipv6_hdr *a = (struct net_ipv6_hdr *)first->ip;
+		struct net_ipv6_hdr *b = (struct net_ipv6_hdr *)hdr->ip;
+
+		if (memcmp(a, b, offsetof(struct net_ipv6_hdr, len)) != 0 ||
+		    a->hop_limit != b->hop_limit ||
+		    memcmp(a->src, b->src, 2 * sizeof(struct in6_addr)) != 0) {
+			return false;
+		}
+	}
+
+	/* Ports, acknowledgment, window and options, everything but the
+	 * sequence number, the flags and the checksum.
+	 */
+	return memcmp(&first->tcp->src_port, &hdr->tcp->src_port,
+		      offsetof(struct net_tcp_hdr, seq)) == 0 &&
+	       memcmp(first->tcp->ack, hdr->tcp->ack, sizeof(hdr->tcp->ack)) == 0 &&
+	       first->tcp->offset == hdr->tcp->offset &&
+	       memcmp(first->tcp->wnd, hdr->tcp->wnd, sizeof(hdr->tcp->wnd)) == 0 &&
+	       memcmp(first->tcp->optdata, hdr->tcp->optdata,
+		      hdr->tcp_len - sizeof(struct net_tcp_hdr)) == 0;
+}
+
+void net_gro_start(struct net_gro *gro, struct net_pkt *pkt)
+{
+	gro->pkt = pkt;
+	gro->count = 1U;
+	gro->open = false;
+
+	if (gro_parse(pkt, &gro->hdr) < 0) {
+		return;
+	}
+
+	/* The header checksum is recalculated when segments are added, so it
+	 * must be right to begin with.
+	 */
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		if ((gro->hdr.ip[0] & 0xf0) == 0x40 &&
+		    calc_chksum(0, gro->hdr.ip, sizeof(struct net_ipv4_hdr)) != 0xffff) {
+			return;
+		}
+
+		gro->payload_sum = gro_payload_chksum(&gro->hdr);
+	}
+
+	gro->len = gro->hdr.payload_len;
+	gro->next_seq = sys_get_be32(gro->hdr.tcp->seq) + gro->len;
+	gro->open = !(gro->hdr.tcp->flags & TCP_FLAG_PSH);
+}
+
+bool net_gro_receive(struct net_gro *gro, struct net_pkt *pkt)
+{
+	struct net_gro_hdr hdr;
+	struct net_buf *buf;
+
+	if (!gro->open || gro_parse(pkt, &hdr) < 0 || !gro_match(gro, pkt, &hdr)) {
+		return false;
+	}
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		uint16_t sum = gro_payload_chksum(&hdr);
+
+		/* Data starting at an odd offset adds up byte swapped */
+		if (gro->len & 1U) {
+			sum = BSWAP_16(sum);
+		}
+
+		gro->payload_sum = gro_chksum_add(gro->payload_sum, sum);
+	}
+
+	/* The end of a burst, or the last segment the sender had to send */
+	if (hdr.payload_len < gro->hdr.payload_len || (hdr.tcp->flags & TCP_FLAG_PSH)) {
+		gro->hdr.tcp->flags |= hdr.tcp->flags & TCP_FLAG_PSH;
+		gro->open = false;
+	}
+
+	gro->len += hdr.payload_len;
+	gro->next_seq += hdr.payload_len;
+	gro->count++;
+
+	/* Only the payload of the segment is kept */
+	buf = pkt->buffer;
+	net_buf_pull(buf, hdr.hdr_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	if (buf) {
+		net_pkt_append_buffer(gro->pkt, buf);
+	}
+
+	return true;
+}
+
+struct net_pkt *net_gro_flush(struct net_gro *gro)
+{
+	struct net_pkt *pkt = gro->pkt;
+	struct net_gro_hdr *hdr = &gro->hdr;
+
+	gro->pkt = NULL;
+
+	if (gro->count == 1U) {
+		return pkt;
+	}
+
+	NET_DBG("Coalesced %u segments, %u bytes into pkt %p", gro->count, gro->len, pkt);
+
+	if ((hdr->ip[0] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr->ip;
+		uint16_t ip_total = htons(hdr->hdr_len - hdr->l2_len + gro->len);
+
+		ipv4_hdr->chksum = net_chksum_update16(ipv4_hdr->chksum, ipv4_hdr->len,
+						       ip_total);
+		ipv4_hdr->len = ip_total;
+	} else {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr->ip;
+
+		ipv6_hdr->len = htons(hdr->hdr_len - hdr->l2_len - sizeof(struct net_ipv6_hdr) +
+				      gro->len);
+	}
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		uint16_t sum;
+
+		hdr->tcp->chksum = 0U;
+		sum = gro_chksum_add(gro_hdr_chksum(hdr, gro->len), gro->payload_sum);
+		hdr->tcp->chksum = htons((uint16_t)~sum);
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NET_GRO */
+
 static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	bool is_loopback = false;
@@ -481,6 +1061,12 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
+#if defined(CONFIG_NET_RPS)
+		if (net_pkt_rx_hash(pkt) == 0U) {
+			net_pkt_set_rx_hash(pkt, rps_hash(pkt));
+		}
+#endif
+
 		net_tc_submit_to_rx_queue(tc, pkt);
 	}
 }
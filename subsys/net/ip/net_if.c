@@ -205,6 +205,19 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+/* Can the device split a TCP packet larger than the MTU by itself */
+static bool net_if_tso_supported(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return !!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+	}
+#endif
+	ARG_UNUSED(iface);
+
+	return false;
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -255,7 +268,13 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+
+		if (net_pkt_gso_size(pkt) > 0U && !net_if_tso_supported(iface)) {
+			status = net_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
+
 		net_if_tx_unlock(iface);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
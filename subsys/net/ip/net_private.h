@@ -132,6 +132,50 @@ extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_GSO)
+/* Split a GSO packet into segments and send them through the L2 of iface.
+ * The packet is consumed on success.
+ */
+extern int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
+#if defined(CONFIG_NET_GRO)
+/* Headers of a TCP segment received by GRO, located in the first buffer
+ * of the packet which still holds the link layer header.
+ */
+struct net_gro_hdr {
+	uint8_t *ip;
+	struct net_tcp_hdr *tcp;
+	uint16_t l2_len;
+	uint16_t tcp_len;
+	uint16_t hdr_len;
+	uint16_t payload_len;
+};
+
+/* Packet the following segments of the same flow are coalesced into */
+struct net_gro {
+	struct net_pkt *pkt;
+	struct net_gro_hdr hdr;
+	uint32_t next_seq;
+	uint32_t len;
+	uint16_t payload_sum;
+	uint16_t count;
+	bool open;
+};
+
+extern void net_gro_start(struct net_gro *gro, struct net_pkt *pkt);
+extern bool net_gro_receive(struct net_gro *gro, struct net_pkt *pkt);
+extern struct net_pkt *net_gro_flush(struct net_gro *gro);
+#endif
+
 char *net_sprint_addr(sa_family_t af, const void *addr);
 
 #define net_sprint_ipv4_addr(_addr) net_sprint_addr(AF_INET, _addr)
@@ -208,6 +252,40 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update a checksum after a 16-bit word it covers has changed,
+ *        without going through all the data again (RFC 1624).
+ *
+ * @param chksum	Checksum field as stored in the header
+ * @param old_val	Old value of the word, in network byte order
+ * @param new_val	New value of the word, in network byte order
+ *
+ * @return The new checksum field value
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint32_t)(uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update a checksum after a 32-bit word it covers has changed,
+ *        see net_chksum_update16().
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, (uint16_t)(old_val >> 16),
+				     (uint16_t)(new_val >> 16));
+
+	return net_chksum_update16(chksum, (uint16_t)old_val, (uint16_t)new_val);
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
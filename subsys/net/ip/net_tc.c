@@ -21,15 +21,24 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With receive packet steering, the RX threads are named "rx_q[y:z]" where
+ * z is the RX queue of the traffic class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y:zz]")
+
+/* Number of RX queues, and threads, for each traffic class */
+#if defined(CONFIG_NET_RPS)
+#define NET_RX_QUEUE_COUNT CONFIG_NET_RPS_QUEUE_COUNT
+#else
+#define NET_RX_QUEUE_COUNT 1
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * NET_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +46,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_COUNT * NET_RX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -63,9 +72,16 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = tc * NET_RX_QUEUE_COUNT;
+
+#if defined(CONFIG_NET_RPS)
+	/* The packets of a flow are always handled by the same queue */
+	queue += net_pkt_rx_hash(pkt) % NET_RX_QUEUE_COUNT;
+#endif
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -247,6 +263,9 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 
 	struct k_fifo *fifo = p1;
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_GRO)
+	struct net_gro gro;
+#endif
 
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
@@ -254,6 +273,20 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 			continue;
 		}
 
+#if defined(CONFIG_NET_GRO)
+		/* Coalesce the segments queued behind this one */
+		net_gro_start(&gro, pkt);
+
+		while ((pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL) {
+			if (!net_gro_receive(&gro, pkt)) {
+				net_process_rx_packet(net_gro_flush(&gro));
+				net_gro_start(&gro, pkt);
+			}
+		}
+
+		pkt = net_gro_flush(&gro);
+#endif
+
 		net_process_rx_packet(pkt);
 	}
 }
@@ -354,12 +387,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_COUNT * NET_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_RX_QUEUE_COUNT);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -386,10 +419,21 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
+#if defined(CONFIG_NET_RPS) && defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues over the CPUs, each flow stays on one */
+		(void)k_thread_cpu_pin(tid, (i % NET_RX_QUEUE_COUNT) % arch_num_cpus());
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (IS_ENABLED(CONFIG_NET_RPS)) {
+				snprintk(name, sizeof(name), "rx_q[%d:%d]",
+					 i / NET_RX_QUEUE_COUNT, i % NET_RX_QUEUE_COUNT);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #endif
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
+#include <zephyr/net/socket.h>
 #include <zephyr/net/udp.h>
 #include "ipv4.h"
 #include "ipv6.h"
@@ -64,10 +65,6 @@ static int tcp_tx_window =
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -439,7 +436,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -455,7 +452,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -469,29 +466,86 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+NET_TCP_CA_DEFINE(reno, tcp_new_reno_init, tcp_new_reno_fast_retransmit,
+		  tcp_new_reno_timeout, tcp_new_reno_dup_ack,
+		  tcp_new_reno_pkts_acked);
+
+static const struct tcp_ca_ops *tcp_ca_default;
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	/* The name is not necessarily terminated within len */
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (len >= strlen(ops->name) && strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca.ops) {
+		/* Keep the window, only the way it evolves changes */
+		conn->ca.ops = ops;
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+#endif
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca.ops->name, *len);
+	((char *)value)[*len - 1] = '\0';
+
+	return 0;
 }
 #else
 
@@ -505,7 +559,56 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
+#endif
+
+/* Round trip time estimation according to RFC6298, a single segment is
+ * timed at a time and retransmitted segments are never timed (Karn).
+ */
+static void tcp_rtt_sample(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+		return;
+	}
+
+	delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+	conn->srtt += delta;
+	conn->rttvar += abs(delta) - (conn->rttvar >> 2);
+}
+
+static int get_tcp_info(struct tcp *conn, void *value, size_t *len)
+{
+	struct tcp_info info = { 0 };
+	uint16_t mss = conn_mss(conn);
+
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	info.tcpi_rto = TCP_RTO_MS * USEC_PER_MSEC;
+	info.tcpi_snd_mss = mss;
+	info.tcpi_unacked = DIV_ROUND_UP(conn->unacked_len, mss);
+	info.tcpi_rtt = (conn->srtt >> 3) * USEC_PER_MSEC;
+	info.tcpi_rttvar = (conn->rttvar >> 2) * USEC_PER_MSEC;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	info.tcpi_snd_ssthresh = conn->ca.ssthresh / mss;
+	info.tcpi_snd_cwnd = conn->ca.cwnd / mss;
 #endif
+	info.tcpi_snd_wnd = conn->send_win;
+	info.tcpi_rcv_wnd = conn->recv_win;
+	info.tcpi_total_retrans = conn->total_retrans;
+
+	*len = MIN(*len, sizeof(info));
+	memcpy(value, &info, *len);
+
+	return 0;
+}
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 
@@ -844,6 +947,35 @@ static int tcp_conn_close(struct tcp *conn, int status)
 	return tcp_conn_unref(conn);
 }
 
+/* A retransmitted segment acknowledges all the data received so far. Only
+ * the acknowledgment number changes, so the checksum is updated instead of
+ * being calculated again.
+ */
+static void tcp_update_ack(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcphdr *th = th_get(pkt);
+	uint32_t old_ack, new_ack;
+
+	if (!th || !(th_flags(th) & ACK)) {
+		return;
+	}
+
+	old_ack = UNALIGNED_GET(&th->th_ack);
+	new_ack = htonl(conn->ack);
+
+	if (old_ack == new_ack) {
+		return;
+	}
+
+	if (net_pkt_is_chksum_done(pkt)) {
+		UNALIGNED_PUT(net_chksum_update32(UNALIGNED_GET(&th->th_sum),
+						  old_ack, new_ack),
+			      &th->th_sum);
+	}
+
+	UNALIGNED_PUT(new_ack, &th->th_ack);
+}
+
 static bool tcp_send_process_no_lock(struct tcp *conn)
 {
 	bool unref = false;
@@ -864,6 +996,7 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 			struct net_pkt *clone = tcp_pkt_clone(pkt);
 
 			if (clone) {
+				tcp_update_ack(conn, clone);
 				tcp_send(clone);
 				conn->send_retries--;
 			}
@@ -1038,7 +1171,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1048,8 +1181,14 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* The options negotiated in the handshake are only valid in SYN
+	 * segments, keep them for the rest of the connection otherwise.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1095,9 +1234,41 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
-			recv_options->wnd_found = true;
+			if (syn) {
+				recv_options->window =
+					MIN(options[2], NET_TCP_MAX_WINDOW_SHIFT);
+				recv_options->wnd_found = true;
+			}
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *blk =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				blk->left = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				blk->right = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
 			break;
+#endif
 		default:
 			continue;
 		}
@@ -1271,8 +1442,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Window advertised to the peer, the one carried by a SYN is never scaled */
+static uint16_t tcp_recv_win_adv(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->recv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1286,14 +1471,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_adv(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1351,23 +1532,73 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_SACK)
+/* The out-of-order data waiting in the receive queue is reported to the
+ * peer in a SACK block. There is a single contiguous block in the queue,
+ * which always holds the most recently received out-of-order segment as
+ * required by RFC 2018 ch 4.
+ */
+static bool tcp_sack_block_get(struct tcp *conn, uint8_t flags,
+			       struct tcp_sack_block *blk)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	if (!conn->sack_ok || !(flags & ACK) || (flags & (SYN | RST)) ||
+	    conn->queue_recv_data == NULL ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return false;
+	}
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	blk->left = tcp_get_seq(conn->queue_recv_data->buffer);
+	blk->right = blk->left + net_pkt_get_len(conn->queue_recv_data);
+
+	return true;
+}
+#endif
+
+/* Build the TCP options of a segment, the length is a multiple of 4 */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block blk;
+#endif
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)&opts[len]);
+		len += NET_TCP_MSS_SIZE;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->send_options.wnd_found) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		opts[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		opts[len++] = conn->recv_wscale;
+	}
+#endif
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_perm_found) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_OPT;
+		opts[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	if (tcp_sack_block_get(conn, flags, &blk)) {
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_OPT;
+		opts[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(blk.left), (uint32_t *)&opts[len]);
+		UNALIGNED_PUT(htonl(blk.right), (uint32_t *)&opts[len + 4]);
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+#endif
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1474,15 +1705,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t opts_len = tcp_options_build(conn, flags, opts);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1492,6 +1720,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1500,14 +1729,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1665,13 +1894,132 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Merge the SACK blocks of an incoming segment into the scoreboard of the
+ * data held by the peer above the cumulative acknowledgment.
+ */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_block blks[2 * NET_TCP_SACK_MAX_BLOCKS];
+	/* Only the data in flight can have reached the peer */
+	uint32_t snd_max = conn->seq + conn->unacked_len;
+	int cnt = 0;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		blks[cnt++] = conn->sacked[i];
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block *blk = &conn->recv_options.sack[i];
+
+		/* Ignore the blocks not covering data we have sent */
+		if (net_tcp_seq_cmp(blk->left, blk->right) >= 0 ||
+		    net_tcp_seq_cmp(blk->left, conn->seq) < 0 ||
+		    net_tcp_seq_cmp(blk->right, snd_max) > 0) {
+			continue;
+		}
+
+		blks[cnt++] = *blk;
+	}
+
+	/* Sort the blocks by their left edge */
+	for (int i = 1; i < cnt; i++) {
+		struct tcp_sack_block blk = blks[i];
+		int j = i;
+
+		for ( ; j > 0 && net_tcp_seq_cmp(blks[j - 1].left, blk.left) > 0; j--) {
+			blks[j] = blks[j - 1];
+		}
+
+		blks[j] = blk;
+	}
+
+	conn->sacked_cnt = 0;
+
+	for (int i = 0; i < cnt; i++) {
+		struct tcp_sack_block *last = conn->sacked_cnt > 0 ?
+			&conn->sacked[conn->sacked_cnt - 1] : NULL;
+
+		if (net_tcp_seq_cmp(blks[i].right, ack) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(blks[i].left, ack) < 0) {
+			blks[i].left = ack;
+		}
+
+		if (last != NULL && net_tcp_seq_cmp(blks[i].left, last->right) <= 0) {
+			if (net_tcp_seq_cmp(blks[i].right, last->right) > 0) {
+				last->right = blks[i].right;
+			}
+
+			continue;
+		}
+
+		/* Out of room, the blocks closest to the ack matter most */
+		if (conn->sacked_cnt == NET_TCP_SACK_MAX_BLOCKS) {
+			break;
+		}
+
+		conn->sacked[conn->sacked_cnt++] = blks[i];
+	}
+}
+
+/* Skip the data the peer already holds, returns how much can be sent
+ * before reaching the next SACKed block.
+ */
+static int tcp_sack_skip(struct tcp *conn)
+{
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		int left = conn->sacked[i].left - conn->seq;
+		int right = conn->sacked[i].right - conn->seq;
+
+		if (conn->unacked_len < left) {
+			return left - conn->unacked_len;
+		}
+
+		if (conn->unacked_len < right) {
+			conn->unacked_len = right;
+		}
+	}
+
+	return INT_MAX;
+}
+#endif
+
+/* Amount of data sent in one packet. With GSO this is as many segments as
+ * fit in CONFIG_NET_GSO_MAX_SIZE, they are split just before reaching the
+ * device. Retransmissions are sent one segment at a time.
+ */
+static int tcp_send_len_max(struct tcp *conn)
+{
+	uint16_t mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_GSO)
+	if (conn->data_mode != TCP_DATA_MODE_RESEND) {
+		return MAX(CONFIG_NET_GSO_MAX_SIZE / mss, 1) * mss;
+	}
+#endif
+
+	return mss;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+#if defined(CONFIG_NET_TCP_SACK)
+	len = MIN(tcp_sack_skip(conn), tcp_send_len_max(conn));
+#else
+	len = tcp_send_len_max(conn);
+#endif
+	len = MIN(tcp_unsent_len(conn), len);
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1682,7 +2030,21 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	if (len > conn_mss(conn)) {
+		/* Not limited to the MTU like tcp_pkt_alloc() */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+
+		if (pkt) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+	}
+
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -1698,6 +2060,21 @@ static int tcp_send_data(struct tcp *conn)
 
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		uint32_t end = conn->seq + conn->unacked_len + len;
+
+		if (net_tcp_seq_cmp(end - len, conn->snd_max) < 0) {
+			conn->total_retrans++;
+			conn->rtt_pending = false;
+		} else if (!conn->rtt_pending) {
+			conn->rtt_pending = true;
+			conn->rtt_seq = end;
+			conn->rtt_start = k_uptime_get_32();
+		}
+
+		if (net_tcp_seq_cmp(end, conn->snd_max) > 0) {
+			conn->snd_max = end;
+		}
+
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1721,6 +2098,34 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Retransmit the holes left between the SACKed blocks, from
+ * conn->sack_rexmit_high up to the highest SACKed byte.
+ */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	int unacked_len = conn->unacked_len;
+	int high;
+
+	if (conn->sacked_cnt == 0) {
+		conn->in_sack_recovery = false;
+		return;
+	}
+
+	high = conn->sacked[conn->sacked_cnt - 1].right - conn->seq;
+	conn->unacked_len = MAX((int32_t)(conn->sack_rexmit_high - conn->seq), 0);
+
+	while (conn->unacked_len < high) {
+		if (tcp_send_data(conn) < 0) {
+			break;
+		}
+	}
+
+	conn->sack_rexmit_high = conn->seq + conn->unacked_len;
+	conn->unacked_len = MAX(unacked_len, conn->unacked_len);
+}
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1812,6 +2217,14 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The peer may have discarded the data it reported, so forget
+	 * about it (RFC 2018 ch 8).
+	 */
+	conn->sacked_cnt = 0;
+	conn->in_sack_recovery = false;
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -2054,9 +2467,9 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
-	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
+	conn->send_win_max = MIN(MAX(tcp_tx_window, NET_IPV6_MTU), NET_TCP_MAX_WIN);
 	conn->send_win = conn->send_win_max;
 	conn->tcp_nodelay = false;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -2066,7 +2479,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = NET_TCP_MAX_WIN;
+	conn->ca.ops = tcp_ca_default;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2162,6 +2576,26 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 	return found ? conn : NULL;
 }
 
+/* The connection handler has already matched the packet to a context. Its
+ * own connection is the one we are looking for, unless the context is
+ * listening, so check that before walking all the connections.
+ */
+static struct tcp *tcp_conn_lookup(struct net_context *context,
+				   struct net_pkt *pkt)
+{
+	struct tcp *conn;
+	bool found;
+
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	conn = context->tcp;
+	found = conn != NULL && tcp_conn_cmp(conn, pkt);
+
+	k_mutex_unlock(&tcp_lock);
+
+	return found ? conn : tcp_conn_search(pkt);
+}
+
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
@@ -2177,7 +2611,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
-	conn = tcp_conn_search(pkt);
+	conn = tcp_conn_lookup(user_data, pkt);
 	if (conn) {
 		goto in;
 	}
@@ -2194,6 +2628,12 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		}
 
 		conn->accepted_conn = conn_old;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		/* Inherit the congestion control of the listener */
+		if (conn_old != NULL) {
+			conn->ca.ops = conn_old->ca.ops;
+		}
+#endif
 	}
 in:
 	if (conn) {
@@ -2392,6 +2832,7 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&local_addr, &context->remote);
+		conn->snd_max = conn->seq;
 	}
 
 	NET_DBG("context: local: %s, remote: %s",
@@ -2684,6 +3125,9 @@ static void tcp_check_sock_options(struct tcp *conn)
 					     &rcvbuf_opt, NULL);
 	}
 
+	sndbuf_opt = MIN(sndbuf_opt, NET_TCP_MAX_WIN);
+	rcvbuf_opt = MIN(rcvbuf_opt, NET_TCP_MAX_WIN);
+
 	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
@@ -2708,6 +3152,58 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Smallest shift making the receive window fit in the 16 bit header field */
+static uint8_t tcp_wscale_get(uint32_t win)
+{
+	uint8_t shift = 0;
+
+	while (shift < NET_TCP_MAX_WINDOW_SHIFT && (win >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Options sent in our SYN, a SYN-ACK only repeats the ones found in the
+ * peer's SYN.
+ */
+static void tcp_syn_options_set(struct tcp *conn, bool syn_ack)
+{
+	conn->send_options.mss_found = true;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->send_options.wnd_found = !syn_ack || conn->recv_options.wnd_found;
+	conn->recv_wscale = tcp_wscale_get(conn->recv_win_max);
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_perm_found = !syn_ack ||
+					      conn->recv_options.sack_perm_found;
+#endif
+}
+
+static void tcp_syn_options_clear(struct tcp *conn)
+{
+	conn->send_options.mss_found = false;
+	conn->send_options.wnd_found = false;
+	conn->send_options.sack_perm_found = false;
+}
+
+/* Once the peer's SYN is known, enable the options both ends have sent */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->wscale_ok = conn->recv_options.wnd_found;
+	conn->send_wscale = conn->recv_options.window;
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+}
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2779,8 +3275,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks are only valid in the segment carrying them */
+	conn->recv_options.sack_cnt = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2805,6 +3307,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		/* The window in a SYN segment is never scaled */
+		if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->send_wscale;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2837,10 +3345,11 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
-			conn->send_options.mss_found = true;
+			tcp_options_negotiate(conn);
+			tcp_syn_options_set(conn, true);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2851,9 +3360,9 @@ next_state:
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
-			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, false);
 			tcp_out(conn, SYN);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_SENT;
 			tcp_conn_ref(conn);
@@ -2958,6 +3467,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3045,6 +3555,12 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th) {
+			tcp_sack_update(conn, th_ack(th));
+		}
+#endif
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3072,6 +3588,14 @@ next_state:
 
 				(void)tcp_send_data(conn);
 
+#if defined(CONFIG_NET_TCP_SACK)
+				/* Then the other holes reported by the peer */
+				conn->sack_rexmit_high = conn->seq + conn->unacked_len;
+				conn->in_sack_recovery = true;
+				conn->unacked_len = temp_unacked_len;
+				tcp_sack_retransmit(conn);
+#endif
+
 				/* Restore the current transmission */
 				conn->unacked_len = temp_unacked_len;
 
@@ -3080,6 +3604,14 @@ next_state:
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
 			}
+
+#if defined(CONFIG_NET_TCP_SACK)
+			/* Further duplicate acks may report new holes */
+			if ((conn->data_mode == TCP_DATA_MODE_SEND) && conn->in_sack_recovery &&
+			    (conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				tcp_sack_retransmit(conn);
+			}
+#endif
 		}
 #endif
 		NET_ASSERT((conn->send_data_total == 0) ||
@@ -3109,6 +3641,12 @@ next_state:
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
+			if (conn->rtt_pending &&
+			    net_tcp_seq_cmp(th_ack(th), conn->rtt_seq) >= 0) {
+				conn->rtt_pending = false;
+				tcp_rtt_sample(conn, k_uptime_get_32() - conn->rtt_start);
+			}
+
 			tcp_ca_pkts_acked(conn, len_acked);
 
 			conn->send_data_total -= len_acked;
@@ -3139,6 +3677,12 @@ next_state:
 				tcp_derive_rto(conn);
 			}
 			conn->data_mode = TCP_DATA_MODE_SEND;
+#if defined(CONFIG_NET_TCP_SACK)
+			/* A partial ack, go on with the holes still left */
+			if (conn->in_sack_recovery) {
+				tcp_sack_retransmit(conn);
+			}
+#endif
 			if (conn->send_data_total > 0) {
 				k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
 					    K_MSEC(TCP_RTO_MS));
@@ -3816,6 +4360,7 @@ int net_tcp_connect(struct net_context *context,
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
+		conn->snd_max = conn->seq;
 	}
 
 	NET_DBG("conn: %p src: %s, dst: %s", conn,
@@ -3979,7 +4524,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
+	/* The checksum of a GSO packet is calculated for each segment */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4355,6 +4902,12 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4392,6 +4945,15 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
+	case TCP_OPT_INFO:
+		ret = get_tcp_info(conn, value, len);
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4459,6 +5021,15 @@ void net_tcp_init(void)
 		tcp_fin_timeout_ms += tcp_fin_timeout_ms >> 1;
 	}
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	tcp_ca_default = tcp_ca_find(CONFIG_NET_TCP_CONGESTION_DEFAULT, TCP_CA_NAME_MAX);
+	if (tcp_ca_default == NULL) {
+		NET_WARN("Unknown congestion control %s, using %s",
+			 CONFIG_NET_TCP_CONGESTION_DEFAULT, "reno");
+		tcp_ca_default = tcp_ca_find("reno", TCP_CA_NAME_MAX);
+	}
+#endif
+
 	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
 	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
 }
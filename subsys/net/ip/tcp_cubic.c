@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control according to RFC9438 */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor beta_cubic = 0.7, scaled by 1024 */
+#define CUBIC_BETA 717
+
+/* Additive increase of the Reno-friendly estimate per round trip after a
+ * reduction, alpha_cubic = 3 * (1 - beta_cubic) / (1 + beta_cubic), scaled
+ * by 1024
+ */
+#define CUBIC_ALPHA 542
+
+/* Keep t^3 within 64 bits, the window is capped well before that */
+#define CUBIC_MAX_T_MS 100000U
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+/* Window growth C * t^3 in bytes after t ms, with C = 0.4 segments/s^3 */
+static uint64_t tcp_cubic_growth(uint32_t t, uint16_t mss)
+{
+	uint64_t t3;
+
+	t = MIN(t, CUBIC_MAX_T_MS);
+	t3 = (uint64_t)t * t * t / 1000000U;
+
+	return t3 * 4U * mss / 10000U;
+}
+
+/* Congestion detected, remember where it happened and back off */
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	cubic->in_epoch = false;
+
+	/* Fast convergence, release bandwidth for new flows */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = ((uint64_t)cwnd * (1024U + CUBIC_BETA)) / 2048U;
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2U,
+				((uint64_t)conn->unacked_len * CUBIC_BETA) / 1024U);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), NET_TCP_MAX_WIN);
+	tcp_cubic_log(conn, "dup_ack");
+}
+
+static void tcp_cubic_avoidance(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint16_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint64_t target;
+	uint32_t alpha;
+	uint32_t t;
+
+	if (!cubic->in_epoch) {
+		cubic->in_epoch = true;
+		cubic->epoch_start = now;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((w_max - cwnd) / C), in ms */
+			cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						  2500000000ULL / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->origin = cwnd;
+		}
+	}
+
+	/* Where the window should be one round trip from now */
+	t = now - cubic->epoch_start + (conn->srtt >> 3);
+	if (t < cubic->k) {
+		uint64_t growth = tcp_cubic_growth(cubic->k - t, mss);
+
+		target = growth < cubic->origin ? cubic->origin - growth : 0U;
+	} else {
+		target = cubic->origin + tcp_cubic_growth(t - cubic->k, mss);
+	}
+
+	target = MIN(target, cwnd + cwnd / 2U);
+
+	/* Never grow slower than New Reno would, which is as fast as New Reno
+	 * once the window before the last reduction is reached again.
+	 */
+	alpha = cubic->w_est >= cubic->w_max ? 1024U : CUBIC_ALPHA;
+	cubic->w_est += ((uint64_t)acked_len * mss * alpha) / 1024U / cwnd;
+
+	if (cubic->w_est > target) {
+		cwnd = MAX(cwnd, cubic->w_est);
+	} else if (target > cwnd) {
+		cwnd += ((target - cwnd) * acked_len) / cwnd;
+	}
+
+	conn->ca.cwnd = MIN(cwnd, NET_TCP_MAX_WIN);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			conn->ca.cwnd = MIN(conn->ca.cwnd + MIN(acked_len, conn_mss(conn)),
+					    NET_TCP_MAX_WIN);
+		} else {
+			tcp_cubic_avoidance(conn, acked_len);
+		}
+	} else {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd -= acked_len;
+		}
+	}
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+NET_TCP_CA_DEFINE(cubic, tcp_cubic_init, tcp_cubic_fast_retransmit,
+		  tcp_cubic_timeout, tcp_cubic_dup_ack, tcp_cubic_pkts_acked);
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/sys/iterable_sections.h>
+
 #include "tp.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
@@ -146,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                               \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -192,10 +194,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,31 +225,115 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest shift allowed in the window scale option (RFC 7323 ch 2.3) */
+#define NET_TCP_MAX_WINDOW_SHIFT 14
+
+/* Number of SACK blocks remembered from the peer */
+#define NET_TCP_SACK_MAX_BLOCKS 4
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SHIFT)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_cnt;
+#endif
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Define the number of MSS sections the congestion window is initialized at */
+#define TCP_CONGESTION_INITIAL_WIN 1
+#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+
+/* Longest congestion control algorithm name, including the terminator */
+#define TCP_CA_NAME_MAX 16
+
+/* Congestion control algorithm. All the callbacks are mandatory and are
+ * called with the connection lock held.
+ */
+struct tcp_ca_ops {
+	/* Name selecting the algorithm with the TCP_CONGESTION option */
+	const char *name;
+	/* Connection got established, set the initial window */
+	void (*init)(struct tcp *conn);
+	/* Third duplicate ack received, the lost segment was resent */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* Retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/* Duplicate ack received */
+	void (*dup_ack)(struct tcp *conn);
+	/* New data got acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+/* Register a congestion control algorithm. Its name is the stringified
+ * _name parameter.
+ */
+#define NET_TCP_CA_DEFINE(_name, _init, _fast_retransmit, _timeout,	\
+			  _dup_ack, _pkts_acked)			\
+	BUILD_ASSERT(sizeof(STRINGIFY(_name)) <= TCP_CA_NAME_MAX);	\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops, _name) = {	\
+		.name = STRINGIFY(_name),				\
+		.init = _init,						\
+		.fast_retransmit = _fast_retransmit,			\
+		.timeout = _timeout,					\
+		.dup_ack = _dup_ack,					\
+		.pkts_acked = _pkts_acked,				\
+	}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_cubic {
+	uint32_t w_max;       /* Window before the last reduction (bytes) */
+	uint32_t origin;      /* Window at the plateau of the curve (bytes) */
+	uint32_t w_est;       /* Reno-friendly window estimate (bytes) */
+	uint32_t k;           /* Time to grow back to w_max (ms) */
+	uint32_t epoch_start; /* Start of the current growth epoch (ms) */
+	bool in_epoch;
 };
 #endif
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	/* Private state of the algorithm, cleared when it is changed */
+	union {
+		struct tcp_cubic cubic;
+	};
+#endif
+};
+#endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -314,16 +396,34 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Data above conn->seq the peer has reported in SACK blocks,
+	 * sorted and merged.
+	 */
+	struct tcp_sack_block sacked[NET_TCP_SACK_MAX_BLOCKS];
+	uint32_t sack_rexmit_high;
+	uint8_t sacked_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t send_wscale;
+	uint8_t recv_wscale;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
 #endif
+	uint32_t snd_max;      /* Highest sequence number sent */
+	uint32_t srtt;         /* Smoothed round trip time (ms << 3) */
+	uint32_t rttvar;       /* Round trip time variation (ms << 2) */
+	uint32_t rtt_seq;      /* Segment end being timed */
+	uint32_t rtt_start;    /* Uptime when the timed segment was sent */
+	uint32_t total_retrans;
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
@@ -336,6 +436,14 @@ struct tcp { /* TCP connection */
 	bool keep_alive : 1;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
+	bool rtt_pending : 1;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	bool wscale_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+	bool in_sack_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -520,6 +520,75 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if defined(CONFIG_NET_CHKSUM_SIMD)
+/* The vector kernels sum len bytes at p, a multiple of CHKSUM_VECTOR_LEN,
+ * as 32-bit words into 64-bit lanes. This is the same sum as the word
+ * based loop below calculates, so they can be mixed freely.
+ */
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#define CHKSUM_VECTOR_LEN 32
+
+static inline uint64_t chksum_vector(const uint32_t *p, size_t len)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i sum_a = zero;
+	__m128i sum_b = zero;
+	uint64_t lanes[2];
+
+	for (; len > 0; len -= CHKSUM_VECTOR_LEN, p += CHKSUM_VECTOR_LEN / sizeof(uint32_t)) {
+		__m128i a = _mm_loadu_si128((const __m128i *)p);
+		__m128i b = _mm_loadu_si128((const __m128i *)(p + 4));
+
+		sum_a = _mm_add_epi64(sum_a, _mm_unpacklo_epi32(a, zero));
+		sum_b = _mm_add_epi64(sum_b, _mm_unpackhi_epi32(a, zero));
+		sum_a = _mm_add_epi64(sum_a, _mm_unpacklo_epi32(b, zero));
+		sum_b = _mm_add_epi64(sum_b, _mm_unpackhi_epi32(b, zero));
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(sum_a, sum_b));
+
+	return lanes[0] + lanes[1];
+}
+#elif defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+
+#define CHKSUM_VECTOR_LEN 32
+
+static inline uint64_t chksum_vector(const uint32_t *p, size_t len)
+{
+	uint64_t sum = 0U;
+
+	for (; len > 0; len -= CHKSUM_VECTOR_LEN, p += CHKSUM_VECTOR_LEN / sizeof(uint32_t)) {
+		sum = vaddlvaq_u32(sum, vld1q_u32(p));
+		sum = vaddlvaq_u32(sum, vld1q_u32(p + 4));
+	}
+
+	return sum;
+}
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+
+#define CHKSUM_VECTOR_LEN 32
+
+static inline uint64_t chksum_vector(const uint32_t *p, size_t len)
+{
+	uint64x2_t sum_a = vdupq_n_u64(0);
+	uint64x2_t sum_b = vdupq_n_u64(0);
+
+	for (; len > 0; len -= CHKSUM_VECTOR_LEN, p += CHKSUM_VECTOR_LEN / sizeof(uint32_t)) {
+		sum_a = vpadalq_u32(sum_a, vld1q_u32(p));
+		sum_b = vpadalq_u32(sum_b, vld1q_u32(p + 4));
+	}
+
+	sum_a = vaddq_u64(sum_a, sum_b);
+
+	return vgetq_lane_u64(sum_a, 0) + vgetq_lane_u64(sum_a, 1);
+}
+#endif
+#endif /* CONFIG_NET_CHKSUM_SIMD */
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -557,6 +626,16 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 	p = (uint32_t *)data;
 
+#if defined(CHKSUM_VECTOR_LEN)
+	if (pending >= CHKSUM_VECTOR_LEN) {
+		size_t vector_len = ROUND_DOWN(pending, CHKSUM_VECTOR_LEN);
+
+		sum += chksum_vector(p, vector_len);
+		pending -= vector_len;
+		i = vector_len / sizeof(uint32_t);
+	}
+#endif
+
 	/* Do loop unrolling for the very large data sets */
 	while (pending >= sizeof(uint32_t) * 4) {
 		uint64_t sum_a = p[i];
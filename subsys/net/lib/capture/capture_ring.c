@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_pkt_filter.h>
+#include <zephyr/net/capture.h>
+
+/* The ring holds ready made pcapng Enhanced Packet Blocks back to back, so
+ * an export only has to prepend the section and interface headers. All the
+ * block lengths are multiples of four, which keeps the length word of every
+ * block aligned and never split by the end of the ring.
+ */
+
+#define PCAPNG_SHB_TYPE   0x0A0D0D0AU
+#define PCAPNG_IDB_TYPE   0x00000001U
+#define PCAPNG_EPB_TYPE   0x00000006U
+#define PCAPNG_BYTE_ORDER 0x1A2B3C4DU
+
+#define LINKTYPE_ETHERNET           1
+#define LINKTYPE_RAW                101
+#define LINKTYPE_IEEE802_15_4_NOFCS 230
+
+#define RING_SIZE ROUND_DOWN(CONFIG_NET_CAPTURE_RING_SIZE, sizeof(uint32_t))
+#define SNAPLEN   CONFIG_NET_CAPTURE_RING_SNAPLEN
+
+struct pcapng_shb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t byte_order;
+	uint16_t major;
+	uint16_t minor;
+	int64_t section_len;
+	uint32_t len2;
+} __packed;
+
+struct pcapng_idb {
+	uint32_t type;
+	uint32_t len;
+	uint16_t linktype;
+	uint16_t reserved;
+	uint32_t snaplen;
+	uint32_t len2;
+} __packed;
+
+struct pcapng_epb {
+	uint32_t type;
+	uint32_t len;
+	uint32_t if_id;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t cap_len;
+	uint32_t orig_len;
+} __packed;
+
+#define EPB_OVERHEAD (sizeof(struct pcapng_epb) + sizeof(uint32_t))
+
+BUILD_ASSERT(RING_SIZE >= 2 * (EPB_OVERHEAD + ROUND_UP(SNAPLEN, sizeof(uint32_t))),
+	     "Capture ring must hold at least two packets");
+
+static uint32_t ring_data[RING_SIZE / sizeof(uint32_t)];
+
+static struct {
+	struct k_spinlock lock;
+	struct npf_rule_list *filter;
+	/* Offset of the oldest block, and number of bytes held from there.
+	 * Both stay below RING_SIZE, which need not be a power of two.
+	 */
+	size_t tail;
+	size_t used;
+	bool running;
+	bool exporting;
+	struct net_capture_ring_stats stats;
+} ring;
+
+static K_MUTEX_DEFINE(export_lock);
+
+static inline uint8_t *ring_ptr(size_t pos)
+{
+	return (uint8_t *)ring_data + (pos % RING_SIZE);
+}
+
+static void ring_write(size_t pos, const void *src, size_t len)
+{
+	size_t first = MIN(len, RING_SIZE - (pos % RING_SIZE));
+
+	memcpy(ring_ptr(pos), src, first);
+	memcpy(ring_ptr(0), (const uint8_t *)src + first, len - first);
+}
+
+static void ring_write_pkt(size_t pos, struct net_pkt *pkt, size_t len)
+{
+	size_t first = MIN(len, RING_SIZE - (pos % RING_SIZE));
+
+	net_buf_linearize(ring_ptr(pos), first, pkt->buffer, 0, first);
+
+	if (len > first) {
+		net_buf_linearize(ring_ptr(0), len - first, pkt->buffer, first,
+				  len - first);
+	}
+}
+
+static uint32_t ring_block_len(size_t pos)
+{
+	return *(uint32_t *)ring_ptr(pos + sizeof(uint32_t));
+}
+
+static uint16_t iface_linktype(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return LINKTYPE_ETHERNET;
+	}
+#endif
+#if defined(CONFIG_NET_L2_IEEE802154)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(IEEE802154)) {
+		return LINKTYPE_IEEE802_15_4_NOFCS;
+	}
+#endif
+
+	return LINKTYPE_RAW;
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	static const uint32_t zero;
+	struct npf_rule_list *filter;
+	struct pcapng_epb epb;
+	k_spinlock_key_t key;
+	uint64_t ts;
+	size_t orig_len, cap_len, pad, head;
+
+	if (!ring.running) {
+		return;
+	}
+
+	filter = ring.filter;
+
+	if (IS_ENABLED(CONFIG_NET_PKT_FILTER) && filter != NULL &&
+	    !net_pkt_filter_rules_ok(filter, pkt)) {
+		key = k_spin_lock(&ring.lock);
+		ring.stats.filtered++;
+		k_spin_unlock(&ring.lock, key);
+		return;
+	}
+
+	orig_len = net_pkt_get_len(pkt);
+	cap_len = MIN(orig_len, SNAPLEN);
+	pad = ROUND_UP(cap_len, sizeof(uint32_t)) - cap_len;
+	ts = k_ticks_to_us_floor64(k_uptime_ticks());
+
+	epb.type = PCAPNG_EPB_TYPE;
+	epb.len = EPB_OVERHEAD + cap_len + pad;
+	epb.if_id = net_if_get_by_iface(iface) - 1;
+	epb.ts_high = (uint32_t)(ts >> 32);
+	epb.ts_low = (uint32_t)ts;
+	epb.cap_len = cap_len;
+	epb.orig_len = orig_len;
+
+	key = k_spin_lock(&ring.lock);
+
+	if (!ring.running) {
+		goto out;
+	}
+
+	if (ring.exporting) {
+		ring.stats.dropped++;
+		goto out;
+	}
+
+	while (RING_SIZE - ring.used < epb.len) {
+		size_t len = ring_block_len(ring.tail);
+
+		ring.tail = (ring.tail + len) % RING_SIZE;
+		ring.used -= len;
+		ring.stats.overwritten++;
+	}
+
+	head = ring.tail + ring.used;
+
+	ring_write(head, &epb, sizeof(epb));
+	ring_write_pkt(head + sizeof(epb), pkt, cap_len);
+	ring_write(head + sizeof(epb) + cap_len, &zero, pad);
+	ring_write(head + epb.len - sizeof(uint32_t), &epb.len, sizeof(uint32_t));
+
+	ring.used += epb.len;
+	ring.stats.captured++;
+
+out:
+	k_spin_unlock(&ring.lock, key);
+}
+
+int net_capture_ring_start(struct npf_rule_list *filter)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (!IS_ENABLED(CONFIG_NET_PKT_FILTER) && filter != NULL) {
+		return -ENOTSUP;
+	}
+
+	key = k_spin_lock(&ring.lock);
+
+	if (ring.exporting) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	ring.filter = filter;
+	ring.tail = 0;
+	ring.used = 0;
+	memset(&ring.stats, 0, sizeof(ring.stats));
+	ring.running = true;
+
+out:
+	k_spin_unlock(&ring.lock, key);
+
+	return ret;
+}
+
+int net_capture_ring_stop(void)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&ring.lock);
+
+	if (!ring.running) {
+		ret = -EALREADY;
+	}
+
+	ring.running = false;
+
+	k_spin_unlock(&ring.lock, key);
+
+	return ret;
+}
+
+struct export_ctx {
+	net_capture_ring_export_cb_t cb;
+	void *user_data;
+	int n_ifaces;
+	int ret;
+};
+
+static void export_idb(struct net_if *iface, void *user_data)
+{
+	struct export_ctx *ctx = user_data;
+	struct pcapng_idb idb = {
+		.type = PCAPNG_IDB_TYPE,
+		.len = sizeof(idb),
+		.linktype = iface_linktype(iface),
+		.snaplen = SNAPLEN,
+		.len2 = sizeof(idb),
+	};
+
+	if (ctx->ret < 0) {
+		return;
+	}
+
+	ctx->ret = ctx->cb(&idb, sizeof(idb), ctx->user_data);
+	ctx->n_ifaces++;
+}
+
+int net_capture_ring_export(net_capture_ring_export_cb_t cb, void *user_data)
+{
+	const struct pcapng_shb shb = {
+		.type = PCAPNG_SHB_TYPE,
+		.len = sizeof(shb),
+		.byte_order = PCAPNG_BYTE_ORDER,
+		.major = 1,
+		.minor = 0,
+		.section_len = -1,
+		.len2 = sizeof(shb),
+	};
+	struct export_ctx ctx = {
+		.cb = cb,
+		.user_data = user_data,
+	};
+	k_spinlock_key_t key;
+	size_t tail, used, first;
+
+	k_mutex_lock(&export_lock, K_FOREVER);
+
+	/* Writers stay out of the ring while it is exported, so its memory
+	 * can be handed to the callback directly.
+	 */
+	key = k_spin_lock(&ring.lock);
+	ring.exporting = true;
+	tail = ring.tail;
+	used = ring.used;
+	k_spin_unlock(&ring.lock, key);
+
+	ctx.ret = cb(&shb, sizeof(shb), user_data);
+
+	net_if_foreach(export_idb, &ctx);
+
+	if (ctx.ret < 0) {
+		goto out;
+	}
+
+	first = MIN(used, RING_SIZE - tail);
+
+	if (first > 0) {
+		ctx.ret = cb(ring_ptr(tail), first, user_data);
+		if (ctx.ret < 0) {
+			goto out;
+		}
+	}
+
+	if (used > first) {
+		ctx.ret = cb(ring_ptr(0), used - first, user_data);
+		if (ctx.ret < 0) {
+			goto out;
+		}
+	}
+
+	ctx.ret = sizeof(shb) + ctx.n_ifaces * sizeof(struct pcapng_idb) + used;
+
+out:
+	key = k_spin_lock(&ring.lock);
+	ring.exporting = false;
+	k_spin_unlock(&ring.lock, key);
+
+	k_mutex_unlock(&export_lock);
+
+	return ctx.ret;
+}
+
+int net_capture_ring_stats_get(struct net_capture_ring_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&ring.lock);
+	*stats = ring.stats;
+	stats->used = ring.used;
+	stats->size = RING_SIZE;
+	k_spin_unlock(&ring.lock, key);
+
+	return 0;
+}
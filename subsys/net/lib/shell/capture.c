@@ -13,6 +13,7 @@ LOG_MODULE_DECLARE(net_shell);
 #include "net_shell_private.h"
 
 #include <zephyr/net/capture.h>
+#include <zephyr/net/net_pkt_filter.h>
 
 #if defined(CONFIG_NET_CAPTURE)
 static const struct device *capture_dev;
@@ -244,6 +245,148 @@ static int cmd_net_capture_disable(const struct shell *sh, size_t argc, char *ar
 	return 0;
 }
 
+#if defined(CONFIG_NET_CAPTURE_RING) && defined(CONFIG_NET_PKT_FILTER)
+static NPF_IFACE_MATCH(ring_iface_match, NULL);
+static NPF_RULE(ring_iface_rule, NET_OK, ring_iface_match);
+static struct npf_rule_list ring_filter;
+#endif
+
+static int cmd_net_capture_ring_start(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct npf_rule_list *filter = NULL;
+	int ret;
+
+	if (argc > 1) {
+#if defined(CONFIG_NET_PKT_FILTER)
+		int if_index = atoi(argv[1]);
+		struct net_if *iface;
+
+		iface = net_if_get_by_index(if_index);
+		if (iface == NULL) {
+			PR_WARNING("No such interface with index %d\n", if_index);
+			return -ENOEXEC;
+		}
+
+		(void)net_capture_ring_stop();
+		(void)npf_remove_all_rules(&ring_filter);
+
+		ring_iface_match.iface = iface;
+		npf_append_rule(&ring_filter, &ring_iface_rule);
+		filter = &ring_filter;
+#else
+		PR_INFO("Set %s to enable %s support.\n",
+			"CONFIG_NET_PKT_FILTER", "capture filter");
+		return -ENOEXEC;
+#endif
+	}
+
+	ret = net_capture_ring_start(filter);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "ring start", ret);
+		return -ENOEXEC;
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_stop(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	(void)net_capture_ring_stop();
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_stats(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct net_capture_ring_stats stats;
+
+	(void)net_capture_ring_stats_get(&stats);
+
+	PR("Captured    : %u\n", stats.captured);
+	PR("Filtered    : %u\n", stats.filtered);
+	PR("Overwritten : %u\n", stats.overwritten);
+	PR("Dropped     : %u\n", stats.dropped);
+	PR("Ring usage  : %u/%u bytes\n", stats.used, stats.size);
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "capture ring");
+#endif
+
+	return 0;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+static int ring_dump_cb(const void *data, size_t len, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const uint8_t *p = data;
+	char line[32 * 2 + 1];
+
+	for (size_t i = 0; i < len; i += 32) {
+		bin2hex(p + i, MIN(len - i, 32), line, sizeof(line));
+		PR("%s\n", line);
+	}
+
+	return 0;
+}
+#endif
+
+static int cmd_net_capture_ring_dump(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	int ret;
+
+	ret = net_capture_ring_export(ring_dump_cb, (void *)sh);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "ring dump", ret);
+		return -ENOEXEC;
+	}
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "capture ring");
+#endif
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture_ring,
+	SHELL_CMD(start, NULL, "Clear the capture ring and start recording.\n"
+		  "'net capture ring start [<interface index>]'\n"
+		  "Without an interface, packets of all interfaces are recorded.",
+		  cmd_net_capture_ring_start),
+	SHELL_CMD(stop, NULL, "Stop recording, keeping the captured packets.",
+		  cmd_net_capture_ring_stop),
+	SHELL_CMD(stats, NULL, "Show capture ring statistics.",
+		  cmd_net_capture_ring_stats),
+	SHELL_CMD(dump, NULL, "Print the capture ring as a hex encoded pcapng file.\n"
+		  "Convert the output back with 'xxd -r -p dump.txt dump.pcapng'.",
+		  cmd_net_capture_ring_dump),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 	SHELL_CMD(setup, NULL, "Setup network packet capture.\n"
 		  "'net capture setup <remote-ip-addr> <local-addr> <peer-addr>'\n"
@@ -261,6 +404,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 		  cmd_net_capture_enable),
 	SHELL_CMD(disable, NULL, "Disable network packet capture.",
 		  cmd_net_capture_disable),
+	SHELL_CMD(ring, &net_cmd_capture_ring, "In-RAM pcapng capture ring.",
+		  NULL),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -137,6 +137,22 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_STATS)
+	PR("\nName\tAllocs\tFailed\tCached\tMinAvail\tAvgCycles\tMaxCycles\n");
+
+	for (int i = 0; i < 2; i++) {
+		struct net_buf_pool *pool = i == 0 ? rx_data : tx_data;
+		struct net_buf_pool_stats stats;
+
+		net_buf_pool_stats_get(pool, &stats);
+
+		PR("%s\t%u\t%u\t%u\t%u\t\t%u\t\t%u\n", i == 0 ? "RX DATA" : "TX DATA",
+		   stats.allocs, stats.failures, stats.cache_hits, stats.min_avail,
+		   (uint32_t)(stats.alloc_cycles / MAX(stats.allocs, 1U)),
+		   stats.max_alloc_cycles);
+	}
+#endif /* CONFIG_NET_BUF_POOL_STATS */
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
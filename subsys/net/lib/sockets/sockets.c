@@ -155,6 +155,8 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+
+	zsock_epoll_notify(ctx);
 }
 
 #if defined(CONFIG_NET_NATIVE)
@@ -274,6 +276,9 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+	/* A closed socket leaves the epoll interest lists it was part of */
+	zsock_epoll_ctx_close(ctx);
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -378,6 +383,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify(parent);
 	}
 
 }
@@ -432,6 +439,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_epoll_notify(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -500,6 +509,8 @@ static void zsock_connected_cb(struct net_context *ctx, int status, void *user_d
 		ctx->user_data = INT_TO_POINTER(-status);
 		sock_set_error(ctx);
 	}
+
+	zsock_epoll_notify(ctx);
 }
 
 int zsock_connect_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -1031,6 +1042,199 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int zsock_sendmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	unsigned int i;
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t len;
+
+		len = zsock_sendmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			if (i == 0) {
+				return -1;
+			}
+
+			/* Report what was sent, the error shows up again
+			 * with the next call.
+			 */
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	return i;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	int sent;
+
+	sent = VTABLE_CALL(sendmmsg, sock, msgvec, vlen, flags);
+
+	for (int i = 0; i < sent; i++) {
+		sock_obj_core_update_send_stats(sock, msgvec[i].msg_len);
+	}
+
+	return sent;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Replace the user space buffers referenced by a msghdr, itself already
+ * copied from user space, with kernel copies of them.
+ */
+static int msghdr_copy_in(struct msghdr *msg)
+{
+	const struct iovec *uiov = msg->msg_iov;
+	void *uname = msg->msg_name;
+	void *ucontrol = msg->msg_control;
+	size_t size;
+	size_t i;
+
+	msg->msg_iov = NULL;
+	msg->msg_name = NULL;
+	msg->msg_control = NULL;
+
+	if (size_mul_overflow(msg->msg_iovlen, sizeof(struct iovec), &size)) {
+		return -EINVAL;
+	}
+
+	if (msg->msg_iovlen > 0) {
+		msg->msg_iov = k_usermode_alloc_from_copy(uiov, size);
+		if (msg->msg_iov == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		void *base = msg->msg_iov[i].iov_base;
+
+		if (msg->msg_iov[i].iov_len == 0) {
+			msg->msg_iov[i].iov_base = NULL;
+			continue;
+		}
+
+		msg->msg_iov[i].iov_base =
+			k_usermode_alloc_from_copy(base, msg->msg_iov[i].iov_len);
+		if (msg->msg_iov[i].iov_base == NULL) {
+			/* Leave nothing for msghdr_copy_free() to free past
+			 * the failure.
+			 */
+			for (i++; i < msg->msg_iovlen; i++) {
+				msg->msg_iov[i].iov_base = NULL;
+			}
+
+			return -ENOMEM;
+		}
+	}
+
+	if (msg->msg_namelen > 0) {
+		msg->msg_name = k_usermode_alloc_from_copy(uname, msg->msg_namelen);
+		if (msg->msg_name == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	if (msg->msg_controllen > 0) {
+		msg->msg_control = k_usermode_alloc_from_copy(ucontrol,
+							      msg->msg_controllen);
+		if (msg->msg_control == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+/* Free the buffers of a msghdr set up by msghdr_copy_in() with iovlen
+ * vectors.
+ */
+static void msghdr_copy_free(struct msghdr *msg, size_t iovlen)
+{
+	if (msg->msg_iov != NULL) {
+		for (size_t i = 0; i < iovlen; i++) {
+			k_free(msg->msg_iov[i].iov_base);
+		}
+	}
+
+	k_free(msg->msg_iov);
+	k_free(msg->msg_name);
+	k_free(msg->msg_control);
+}
+
+/* Replace the user space buffers referenced by an mmsghdr array, itself
+ * already copied from user space, with kernel copies of them. Only the first
+ * count messages are set up on failure.
+ */
+static int mmsghdr_copy_in(struct mmsghdr *msgvec, unsigned int vlen,
+			   unsigned int *count)
+{
+	int ret;
+
+	for (*count = 0; *count < vlen; (*count)++) {
+		ret = msghdr_copy_in(&msgvec[*count].msg_hdr);
+		if (ret < 0) {
+			/* Partially set up, free it as well */
+			(*count)++;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int count;
+	int fault = 0;
+	int ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(struct mmsghdr));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* All the messages are copied first, so that the socket is only
+	 * looked up and locked once for all of them.
+	 */
+	ret = mmsghdr_copy_in(msgvec_copy, vlen, &count);
+	if (ret == 0) {
+		ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+	} else {
+		errno = -ret;
+		ret = -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		fault |= k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					    sizeof(msgvec[i].msg_len));
+	}
+
+	for (unsigned int i = 0; i < count; i++) {
+		msghdr_copy_free(&msgvec_copy[i].msg_hdr, msgvec_copy[i].msg_hdr.msg_iovlen);
+	}
+
+	k_free(msgvec_copy);
+
+	K_OOPS(fault);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -2024,6 +2228,413 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int zsock_recvmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+			      unsigned int vlen, int flags)
+{
+	unsigned int i;
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t len;
+
+		len = zsock_recvmsg_ctx(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			if (i == 0) {
+				return -1;
+			}
+
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return i;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	int received;
+
+	received = VTABLE_CALL(recvmmsg, sock, msgvec, vlen, flags);
+
+	for (int i = 0; i < received; i++) {
+		sock_obj_core_update_recv_stats(sock, msgvec[i].msg_len);
+	}
+
+	return received;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Copy what was received into a msghdr set up by msghdr_copy_in() back to
+ * the user space msghdr it was copied from, umsg being a copy of the latter.
+ */
+static int msghdr_copy_out(struct msghdr *dst, const struct msghdr *umsg,
+			   const struct msghdr *msg)
+{
+	struct iovec uiov;
+	int ret = 0;
+
+	if (umsg->msg_namelen > 0 && umsg->msg_name != NULL) {
+		socklen_t namelen = MIN(msg->msg_namelen, umsg->msg_namelen);
+
+		ret |= k_usermode_to_copy(umsg->msg_name, msg->msg_name, namelen);
+		ret |= k_usermode_to_copy(&dst->msg_namelen, &namelen, sizeof(namelen));
+	}
+
+	if (umsg->msg_controllen > 0 && umsg->msg_control != NULL) {
+		ret |= k_usermode_to_copy(umsg->msg_control, msg->msg_control,
+					  msg->msg_controllen);
+		ret |= k_usermode_to_copy(&dst->msg_controllen, &msg->msg_controllen,
+					  sizeof(msg->msg_controllen));
+	}
+
+	/* The received data fills the first vectors, clear the others */
+	for (size_t i = 0; i < umsg->msg_iovlen && ret == 0; i++) {
+		size_t len = 0;
+
+		ret |= k_usermode_from_copy(&uiov, &umsg->msg_iov[i], sizeof(uiov));
+
+		if (ret == 0 && i < msg->msg_iovlen) {
+			len = msg->msg_iov[i].iov_len;
+			ret |= k_usermode_to_copy(uiov.iov_base, msg->msg_iov[i].iov_base, len);
+		}
+
+		ret |= k_usermode_to_copy(&umsg->msg_iov[i].iov_len, &len, sizeof(len));
+	}
+
+	ret |= k_usermode_to_copy(&dst->msg_iovlen, &msg->msg_iovlen, sizeof(msg->msg_iovlen));
+	ret |= k_usermode_to_copy(&dst->msg_flags, &msg->msg_flags, sizeof(msg->msg_flags));
+
+	return ret;
+}
+
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	struct mmsghdr *msgvec_user;
+	unsigned int count;
+	int fault = 0;
+	int ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags);
+	}
+
+	/* Keep the user space headers as they were at the time of the call,
+	 * to copy the data back to the buffers that were verified.
+	 */
+	msgvec_user = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(struct mmsghdr));
+	if (msgvec_user == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	msgvec_copy = k_malloc(vlen * sizeof(struct mmsghdr));
+	if (msgvec_copy == NULL) {
+		k_free(msgvec_user);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	memcpy(msgvec_copy, msgvec_user, vlen * sizeof(struct mmsghdr));
+
+	/* All the messages are copied first, so that the socket is only
+	 * looked up and locked once for all of them.
+	 */
+	ret = mmsghdr_copy_in(msgvec_copy, vlen, &count);
+	if (ret == 0) {
+		ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+	} else {
+		errno = -ret;
+		ret = -1;
+	}
+
+	for (int i = 0; i < ret && fault == 0; i++) {
+		fault |= msghdr_copy_out(&msgvec[i].msg_hdr, &msgvec_user[i].msg_hdr,
+					 &msgvec_copy[i].msg_hdr);
+		fault |= k_usermode_to_copy(&msgvec[i].msg_len, &msgvec_copy[i].msg_len,
+					    sizeof(msgvec[i].msg_len));
+	}
+
+	/* The receive may have lowered msg_iovlen, free the original count */
+	for (unsigned int i = 0; i < count; i++) {
+		msghdr_copy_free(&msgvec_copy[i].msg_hdr, msgvec_user[i].msg_hdr.msg_iovlen);
+	}
+
+	k_free(msgvec_copy);
+	k_free(msgvec_user);
+
+	K_OOPS(fault);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY)
+/* Hand over the unread data of a packet as a buffer chain, the packet
+ * itself is released.
+ */
+static struct net_buf *sock_pkt_take_data(struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+
+	if (pkt->buffer != NULL && pkt->buffer->ref > 1) {
+		/* The buffers are shared with another packet, detach a copy */
+		struct net_pkt *clone = net_pkt_clone(pkt, K_NO_WAIT);
+
+		net_pkt_unref(pkt);
+		if (clone == NULL) {
+			return NULL;
+		}
+
+		pkt = clone;
+	}
+
+	/* Drop the buffers holding headers or data already read */
+	while (pkt->buffer != NULL && pkt->buffer != pkt->cursor.buf) {
+		pkt->buffer = net_buf_frag_del(NULL, pkt->buffer);
+	}
+
+	buf = pkt->buffer;
+	if (buf != NULL) {
+		net_buf_pull(buf, pkt->cursor.pos - buf->data);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	return buf;
+}
+
+static ssize_t zsock_recv_buf_ctx(struct net_context *ctx, struct net_buf **buf,
+				  int flags, struct sockaddr *src_addr,
+				  socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	int ret;
+
+	if ((flags & ZSOCK_MSG_PEEK) ||
+	    (sock_type != SOCK_DGRAM && sock_type != SOCK_STREAM) ||
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM &&
+	    net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	do {
+		if (sock_type == SOCK_STREAM) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			}
+
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		recv_len = net_pkt_remaining_data(pkt);
+		if (sock_type == SOCK_STREAM && recv_len == 0) {
+			/* Nothing left to read in this segment */
+			net_pkt_unref(pkt);
+			pkt = NULL;
+		}
+	} while (pkt == NULL);
+
+	if (sock_type == SOCK_DGRAM && src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+
+		*addrlen = src_addr->sa_family == AF_INET6 ?
+			   sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	if (recv_len > 0) {
+		*buf = sock_pkt_take_data(pkt);
+		if (*buf == NULL) {
+			errno = ENOMEM;
+			return -1;
+		}
+	} else {
+		net_pkt_unref(pkt);
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, recv_len);
+	}
+
+	return recv_len;
+}
+
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t bytes_received;
+	void *ctx;
+
+	*buf = NULL;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only sockets of the native network stack hold packets */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	bytes_received = zsock_recv_buf_ctx(ctx, buf, flags, src_addr, addrlen);
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+static ssize_t zsock_send_buf_ctx(struct net_context *ctx, struct net_buf *buf,
+				  int flags, const struct sockaddr *dest_addr,
+				  socklen_t addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_sendto_buf(ctx, buf, dest_addr, addrlen,
+						NULL, timeout, ctx->user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t bytes_sent;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	bytes_sent = zsock_send_buf_ctx(ctx, buf, flags, dest_addr, addrlen);
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return bytes_sent;
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2633,6 +3244,29 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 
 			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case TCP_INFO:
+			ret = net_tcp_get_option(ctx, TCP_OPT_INFO, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
 		}
 
 		break;
@@ -3169,6 +3803,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -3666,6 +4314,18 @@ static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
 	return zsock_recvmsg_ctx(obj, msg, flags);
 }
 
+static int sock_sendmmsg_vmeth(void *obj, struct mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
+static int sock_recvmmsg_vmeth(void *obj, struct mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -3717,6 +4377,8 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvmsg = sock_recvmsg_vmeth,
+	.sendmmsg = sock_sendmmsg_vmeth,
+	.recvmmsg = sock_recvmmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/net/socket.h>
+
+#include "sockets_internal.h"
+#include "../../ip/tcp_internal.h"
+
+/* Events that are reported whether they were asked for or not */
+#define EPOLL_ALWAYS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | EPOLL_ALWAYS)
+
+struct zsock_epoll_item;
+
+__net_socket struct zsock_epoll {
+	/* Every entry of the interest list */
+	sys_dlist_t items;
+
+	/* Entries which may be ready, queued by the socket callbacks */
+	sys_dlist_t ready;
+
+	/* Raised when an entry is queued to the ready list */
+	struct k_poll_signal signal;
+
+	/* Is this instance in use (true) or not (false) */
+	bool in_use;
+};
+
+struct zsock_epoll_item {
+	/* Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+
+	/* Node in the interest list of the instance */
+	sys_dnode_t node;
+
+	/* Node in the epoll_items list of the socket */
+	sys_snode_t ctx_node;
+
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	zsock_epoll_data_t data;
+
+	/* Events of interest, 0 once a ZSOCK_EPOLLONESHOT entry fired */
+	uint32_t events;
+};
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+static const struct socket_op_vtable epoll_fd_op_vtable;
+
+static struct zsock_epoll epolls[CONFIG_NET_SOCKETS_EPOLL_MAX];
+/* Entries are free when not attached to an instance */
+static struct zsock_epoll_item epoll_items[CONFIG_NET_SOCKETS_EPOLL_ITEMS];
+
+/* Protects the instances, the entries and the epoll_items of the sockets */
+static struct k_spinlock epoll_lock;
+
+static struct zsock_epoll_item *epoll_item_alloc(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].ep == NULL) {
+			return &epoll_items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void epoll_item_free(struct zsock_epoll_item *item)
+{
+	sys_dlist_remove(&item->node);
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	(void)sys_slist_find_and_remove(&item->ctx->epoll_items, &item->ctx_node);
+
+	item->ctx = NULL;
+	item->ep = NULL;
+}
+
+static struct zsock_epoll_item *epoll_item_find(struct zsock_epoll *ep,
+						struct net_context *ctx)
+{
+	struct zsock_epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->ep == ep) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+static bool epoll_is_native_tcp(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM &&
+	       !net_if_is_ip_offloaded(net_context_get_iface(ctx));
+}
+
+/* Same conditions as zsock_poll_update_ctx() */
+static uint32_t epoll_item_revents(struct zsock_epoll_item *item)
+{
+	struct net_context *ctx = item->ctx;
+	uint32_t revents = 0U;
+
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLIN;
+	}
+
+	if (!epoll_is_native_tcp(ctx)) {
+		revents |= ZSOCK_EPOLLOUT;
+	} else if (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+		   !sock_is_eof(ctx) &&
+		   k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0) {
+		revents |= ZSOCK_EPOLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		revents |= ZSOCK_EPOLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_EPOLLHUP;
+	}
+
+	return revents & (item->events | EPOLL_ALWAYS);
+}
+
+/* Opening of the send window of a TCP connection is not notified, so a
+ * connected TCP socket waiting to become writable stays in the ready list
+ * and the wait is done on the semaphore of its send window.
+ */
+static struct k_sem *epoll_item_tx_sem(struct zsock_epoll_item *item)
+{
+	struct net_context *ctx = item->ctx;
+
+	if ((item->events & ZSOCK_EPOLLOUT) && epoll_is_native_tcp(ctx) &&
+	    net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+	    !sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		return net_tcp_tx_sem_get(ctx);
+	}
+
+	return NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct zsock_epoll *eps[CONFIG_NET_SOCKETS_EPOLL_MAX];
+	struct zsock_epoll_item *item;
+	k_spinlock_key_t key;
+	int n = 0;
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->events == 0U) {
+			continue;
+		}
+
+		if (!sys_dnode_is_linked(&item->ready_node)) {
+			sys_dlist_append(&item->ep->ready, &item->ready_node);
+		}
+
+		if (n < ARRAY_SIZE(eps)) {
+			eps[n++] = item->ep;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	/* Raising a signal may reschedule, do it without the lock held */
+	for (int i = 0; i < n; i++) {
+		k_poll_signal_raise(&eps[i]->signal, 0);
+	}
+}
+
+void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_slist_peek_head(&ctx->epoll_items)) != NULL) {
+		epoll_item_free(CONTAINER_OF(node, struct zsock_epoll_item, ctx_node));
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct zsock_epoll *ep = NULL;
+	k_spinlock_key_t key;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	k_poll_signal_init(&ep->signal);
+
+#ifdef CONFIG_USERSPACE
+	/* Only the creator gets access to the instance, not the threads
+	 * granted access to it by a previous owner.
+	 */
+	k_object_recycle(ep);
+#endif /* CONFIG_USERSPACE */
+
+	z_finalize_fd(fd, ep,
+		      (const struct fd_op_vtable *)&epoll_fd_op_vtable);
+
+	NET_DBG("epoll: ep=%p, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <syscalls/zsock_epoll_create_mrsh.c>
+
+/* The descriptor table is shared by all the threads, make sure the caller
+ * has been granted access to the instance behind @p epfd.
+ */
+static bool epoll_access_ok(int epfd)
+{
+	struct zsock_epoll *ep;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)&epoll_fd_op_vtable,
+			  EINVAL);
+	if (ep != NULL && !k_object_is_valid(ep, K_OBJ_NET_SOCKET)) {
+		NET_ERR("invalid access on epoll %d by thread %p", epfd,
+			_current);
+		errno = EBADF;
+		return false;
+	}
+
+	/* Invalid descriptors are reported by the implementation */
+	return true;
+}
+#endif /* CONFIG_USERSPACE */
+
+static int epoll_ctl_locked(struct zsock_epoll *ep, int op, struct net_context *ctx,
+			    int fd, struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_item *item;
+
+	if (!ep->in_use) {
+		return -EBADF;
+	}
+
+	item = epoll_item_find(ep, ctx);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			return -EEXIST;
+		}
+
+		item = epoll_item_alloc();
+		if (item == NULL) {
+			return -ENOSPC;
+		}
+
+		item->ep = ep;
+		item->ctx = ctx;
+		sys_dnode_init(&item->ready_node);
+		sys_dlist_append(&ep->items, &item->node);
+		sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			return -ENOENT;
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			return -ENOENT;
+		}
+
+		epoll_item_free(item);
+		return 0;
+
+	default:
+		return -EINVAL;
+	}
+
+	item->events = event->events & (EPOLL_EVENTS | ZSOCK_EPOLLONESHOT);
+	item->data = event->data;
+
+	/* Let the next wait find out the current state of the socket */
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&ep->ready, &item->ready_node);
+	}
+
+	NET_DBG("epoll: ep=%p, op=%d, fd=%d, events=0x%x", ep, op, fd,
+		item->events);
+
+	return 0;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zsock_epoll *ep;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)&epoll_fd_op_vtable,
+			  EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	ctx = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	/* Only the native stack calls back when sockets become ready */
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable) {
+		errno = EPERM;
+		return -1;
+	}
+
+	/* The socket lock keeps the socket from being closed meanwhile */
+	(void)k_mutex_lock(lock, K_FOREVER);
+	key = k_spin_lock(&epoll_lock);
+
+	ret = epoll_ctl_locked(ep, op, ctx, fd, event);
+
+	k_spin_unlock(&epoll_lock, key);
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	/* The socket may be ready already */
+	k_poll_signal_raise(&ep->signal, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+	struct net_context *ctx;
+
+	if (!epoll_access_ok(epfd)) {
+		return -1;
+	}
+
+	ctx = z_get_fd_obj(fd, NULL, EBADF);
+	if (ctx != NULL && !k_object_is_valid(ctx, K_OBJ_NET_SOCKET)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (op == ZSOCK_EPOLL_CTL_DEL || event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, NULL);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, (void *)event,
+				    sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Report the ready entries of @p ep, returns the number of entries stored
+ * in @p events. Entries found not to be ready are dropped from the ready
+ * list, apart from TCP sockets waiting for their send window, whose
+ * semaphores are added to @p poll_events instead.
+ */
+static int epoll_collect(struct zsock_epoll *ep, struct zsock_epoll_event *events,
+			 int maxevents, struct k_poll_event *poll_events,
+			 int *n_poll, int max_poll)
+{
+	struct zsock_epoll_item *item, *next;
+	sys_dlist_t reported;
+	int n = 0;
+
+	sys_dlist_init(&reported);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->ready, item, next, ready_node) {
+		uint32_t revents;
+		struct k_sem *sem;
+
+		if (n == maxevents) {
+			break;
+		}
+
+		revents = item->events != 0U ? epoll_item_revents(item) : 0U;
+		if (revents != 0U) {
+			events[n].events = revents;
+			events[n].data = item->data;
+			n++;
+
+			sys_dlist_remove(&item->ready_node);
+
+			if (item->events & ZSOCK_EPOLLONESHOT) {
+				item->events = 0U;
+			} else {
+				/* Level-triggered, report it again until the
+				 * condition is cleared
+				 */
+				sys_dlist_append(&reported, &item->ready_node);
+			}
+
+			continue;
+		}
+
+		sem = item->events != 0U ? epoll_item_tx_sem(item) : NULL;
+		if (sem != NULL) {
+			if (*n_poll < max_poll) {
+				k_poll_event_init(&poll_events[*n_poll],
+						  K_POLL_TYPE_SEM_AVAILABLE,
+						  K_POLL_MODE_NOTIFY_ONLY, sem);
+				(*n_poll)++;
+			}
+
+			continue;
+		}
+
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	/* Queue the reported entries behind the others, so that a small
+	 * maxevents does not starve the sockets further in the list.
+	 */
+	while (!sys_dlist_is_empty(&reported)) {
+		sys_dnode_t *node = sys_dlist_get(&reported);
+
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	return n;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event poll_events[1 + CONFIG_NET_SOCKETS_EPOLL_WAIT_MAX];
+	struct zsock_epoll *ep;
+	k_timepoint_t end;
+	k_spinlock_key_t key;
+	int n_poll;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, (const struct fd_op_vtable *)&epoll_fd_op_vtable,
+			  EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0 || events == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		/* Reset before looking at the ready list, so that anything
+		 * queued from now on wakes up the wait below.
+		 */
+		k_poll_signal_reset(&ep->signal);
+
+		k_poll_event_init(&poll_events[0], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->signal);
+		n_poll = 1;
+
+		key = k_spin_lock(&epoll_lock);
+
+		if (!ep->in_use) {
+			k_spin_unlock(&epoll_lock, key);
+			errno = EBADF;
+			return -1;
+		}
+
+		ret = epoll_collect(ep, events, maxevents, poll_events, &n_poll,
+				    ARRAY_SIZE(poll_events));
+
+		k_spin_unlock(&epoll_lock, key);
+
+		if (ret > 0) {
+			return ret;
+		}
+
+		ret = k_poll(poll_events, n_poll, sys_timepoint_timeout(end));
+		if (ret == -EAGAIN) {
+			return 0;
+		}
+
+		if (ret < 0 && ret != -EINTR) {
+			errno = -ret;
+			return -1;
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (!epoll_access_ok(epfd)) {
+		return -1;
+	}
+
+	if (maxevents > 0) {
+		K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+						    sizeof(struct zsock_epoll_event)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	return -EOPNOTSUPP;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct zsock_epoll *ep = obj;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_dlist_peek_head(&ep->items)) != NULL) {
+		epoll_item_free(CONTAINER_OF(node, struct zsock_epoll_item, node));
+	}
+
+	ep->in_use = false;
+
+	k_spin_unlock(&epoll_lock, key);
+
+	/* Wake up threads still waiting on the instance */
+	k_poll_signal_raise(&ep->signal, 0);
+
+	return 0;
+}
+
+/* Epoll instances are socket kernel objects, so that user threads can be
+ * granted them, and socket calls on them go through this table too. Its
+ * socket operations are left NULL, failing those calls with EOPNOTSUPP.
+ */
+static const struct socket_op_vtable epoll_fd_op_vtable = {
+	.fd_vtable = {
+		.read = epoll_read_vmeth,
+		.write = epoll_write_vmeth,
+		.close = epoll_close_vmeth,
+		.ioctl = epoll_ioctl_vmeth,
+	},
+};
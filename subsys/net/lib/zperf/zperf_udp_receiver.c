@@ -12,6 +12,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 
+#include <zephyr/net/buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/socket_service.h>
 #include <zephyr/net/zperf.h>
@@ -307,14 +308,87 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
-static int udp_recv_data(struct net_socket_service_event *pev)
+#if defined(CONFIG_NET_ZPERF_ZERO_COPY)
+static ssize_t udp_recv_hdr(int sock, uint8_t *buf, struct sockaddr *addr,
+			    socklen_t *addrlen)
+{
+	struct net_buf *frags = NULL;
+	ssize_t ret;
+
+	ret = zsock_recv_buf(sock, &frags, 0, addr, addrlen);
+	if (frags != NULL) {
+		/* Only the zperf header is looked at, leave the payload be */
+		(void)net_buf_linearize(buf, sizeof(struct zperf_udp_datagram),
+					frags, 0, sizeof(struct zperf_udp_datagram));
+		net_buf_unref(frags);
+	}
+
+	return ret;
+}
+
+#define UDP_BATCH 1
+#else
+#define UDP_BATCH CONFIG_NET_ZPERF_UDP_BATCH
+#endif /* CONFIG_NET_ZPERF_ZERO_COPY */
+
+#if UDP_BATCH > 1
+static struct sockaddr udp_addrs[UDP_BATCH];
+static uint8_t udp_bufs[UDP_BATCH][UDP_RECEIVER_BUF_SIZE];
+static struct iovec udp_iov[UDP_BATCH];
+static struct mmsghdr udp_msgs[UDP_BATCH];
+
+/* Receive the datagrams queued on the socket at once. Each one is copied
+ * as with udp_recv_one(), so that only the number of calls differs.
+ */
+static int udp_recv_batch(int sock)
+{
+	int ret;
+
+	for (int i = 0; i < UDP_BATCH; i++) {
+		udp_iov[i].iov_base = udp_bufs[i];
+		udp_iov[i].iov_len = sizeof(udp_bufs[i]);
+
+		udp_msgs[i].msg_hdr.msg_name = &udp_addrs[i];
+		udp_msgs[i].msg_hdr.msg_namelen = sizeof(udp_addrs[i]);
+		udp_msgs[i].msg_hdr.msg_iov = &udp_iov[i];
+		udp_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	ret = zsock_recvmmsg(sock, udp_msgs, UDP_BATCH, ZSOCK_MSG_WAITFORONE);
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &udp_addrs[i], udp_bufs[i],
+			     udp_msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#else
+static int udp_recv_one(int sock)
 {
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+#if defined(CONFIG_NET_ZPERF_ZERO_COPY)
+	ret = udp_recv_hdr(sock, buf, &addr, &addrlen);
+#else
+	ret = zsock_recvfrom(sock, buf, sizeof(buf), 0, &addr, &addrlen);
+#endif
+	if (ret >= 0) {
+		udp_received(sock, &addr, buf, ret);
+	}
+
+	return ret;
+}
+#endif /* UDP_BATCH > 1 */
+
+static int udp_recv_data(struct net_socket_service_event *pev)
+{
 	int ret = 0;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -336,8 +410,11 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
-	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
-			     &addr, &addrlen);
+#if UDP_BATCH > 1
+	ret = udp_recv_batch(pev->event.fd);
+#else
+	ret = udp_recv_one(pev->event.fd);
+#endif
 	if (ret < 0) {
 		ret = -errno;
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
@@ -347,8 +424,6 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
-	udp_received(pev->event.fd, &addr, buf, ret);
-
 	return ret;
 
 error:
@@ -9,6 +9,7 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 
+#include <zephyr/net/buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/zperf.h>
 
@@ -20,6 +21,77 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
+#define UDP_HDR_SIZE (sizeof(struct zperf_udp_datagram) + \
+		      sizeof(struct zperf_client_hdr_v1))
+
+#if defined(CONFIG_NET_ZPERF_ZERO_COPY)
+#define UDP_BATCH 1
+
+/* One buffer for the header of each datagram in flight and one wrapping
+ * its payload, which is never copied.
+ */
+NET_BUF_POOL_DEFINE(udp_tx_pool, 2 * CONFIG_NET_PKT_TX_COUNT, UDP_HDR_SIZE, 0,
+		    NULL);
+
+static int udp_send(int sock, uint32_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, UDP_HDR_SIZE);
+	struct net_buf *buf, *payload;
+	int ret;
+
+	buf = net_buf_alloc(&udp_tx_pool, K_FOREVER);
+	net_buf_add_mem(buf, sample_packet, hdr_len);
+
+	if (packet_size > hdr_len) {
+		payload = net_buf_alloc_with_data(&udp_tx_pool,
+						  sample_packet + hdr_len,
+						  packet_size - hdr_len,
+						  K_FOREVER);
+		net_buf_frag_add(buf, payload);
+	}
+
+	ret = zsock_send_buf(sock, buf, 0, NULL, 0);
+
+	net_buf_unref(buf);
+
+	return ret;
+}
+#else
+#define UDP_BATCH CONFIG_NET_ZPERF_UDP_BATCH
+#endif /* CONFIG_NET_ZPERF_ZERO_COPY */
+
+#if UDP_BATCH > 1
+static uint8_t udp_hdrs[UDP_BATCH][UDP_HDR_SIZE];
+static struct iovec udp_iov[UDP_BATCH][2];
+static struct mmsghdr udp_msgs[UDP_BATCH];
+
+/* Send UDP_BATCH copies of the sample packet with consecutive ids, each
+ * one with its own header in front of the shared payload.
+ */
+static int udp_send_batch(int sock, uint32_t id, uint32_t packet_size)
+{
+	size_t hdr_len = MIN(packet_size, UDP_HDR_SIZE);
+
+	for (int i = 0; i < UDP_BATCH; i++) {
+		struct zperf_udp_datagram *datagram =
+			(struct zperf_udp_datagram *)udp_hdrs[i];
+
+		memcpy(udp_hdrs[i], sample_packet, hdr_len);
+		datagram->id = htonl(id + i);
+
+		udp_iov[i][0].iov_base = udp_hdrs[i];
+		udp_iov[i][0].iov_len = hdr_len;
+		udp_iov[i][1].iov_base = sample_packet + hdr_len;
+		udp_iov[i][1].iov_len = packet_size - hdr_len;
+
+		udp_msgs[i].msg_hdr.msg_iov = udp_iov[i];
+		udp_msgs[i].msg_hdr.msg_iovlen = 2;
+	}
+
+	return zsock_sendmmsg(sock, udp_msgs, UDP_BATCH, 0);
+}
+#endif /* UDP_BATCH > 1 */
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -145,7 +217,8 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
-	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
+	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps) *
+				      UDP_BATCH;
 	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
@@ -227,10 +300,18 @@ static int udp_upload(int sock, int port,
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
+#if defined(CONFIG_NET_ZPERF_ZERO_COPY)
+		ret = udp_send(sock, packet_size);
+#elif UDP_BATCH > 1
+		ret = udp_send_batch(sock, nb_packets, packet_size);
+#else
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
+#endif
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
+		} else if (UDP_BATCH > 1) {
+			nb_packets += ret;
 		} else {
 			nb_packets++;
 		}
@@ -48,6 +48,14 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	uint32_t index_hash[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	uint16_t index_id[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	uint16_t index_used;
+	uint16_t free_name_id;
+	bool index_complete;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -11,6 +11,7 @@
 #include <zephyr/settings/settings.h>
 #include "settings/settings_nvs.h"
 #include <zephyr/sys/crc.h>
+#include <zephyr/sys/hash_function.h>
 #include "settings_priv.h"
 #include <zephyr/storage/flash_map.h>
 
@@ -120,6 +121,157 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+/* The name index is an open addressed hash table (linear probing) holding the
+ * name hash and name ID of every stored setting. A lookup reads back only the
+ * names whose hash matches, normally just the one it is looking for. At most
+ * 3/4 of the slots are used; names that don't fit are left out and the index
+ * is marked as incomplete, after which lookups that miss fall back to
+ * iterating over the name IDs.
+ */
+#define SETTINGS_NVS_INDEX_MASK (CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE - 1)
+#define SETTINGS_NVS_INDEX_MAX_USED (CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE * 3 / 4)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE),
+	     "CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE must be a power of 2");
+
+static inline uint32_t settings_nvs_name_hash(const char *name)
+{
+	return sys_hash32_murmur3(name, strlen(name));
+}
+
+static uint16_t settings_nvs_index_find(struct settings_nvs *cf, const char *name,
+					uint32_t name_hash, char *rdname, size_t len)
+{
+	size_t pos = name_hash & SETTINGS_NVS_INDEX_MASK;
+	int rc;
+
+	for (; cf->index_id[pos] != NVS_NAMECNT_ID;
+	     pos = (pos + 1) & SETTINGS_NVS_INDEX_MASK) {
+		if (cf->index_hash[pos] != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->index_id[pos], rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		return cf->index_id[pos];
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+static void settings_nvs_index_add(struct settings_nvs *cf, uint32_t name_hash,
+				   uint16_t name_id)
+{
+	size_t pos = name_hash & SETTINGS_NVS_INDEX_MASK;
+
+	if (cf->index_used >= SETTINGS_NVS_INDEX_MAX_USED) {
+		if (cf->index_complete) {
+			LOG_WRN("Name index full, consider increasing "
+				"CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE");
+			cf->index_complete = false;
+		}
+		return;
+	}
+
+	while (cf->index_id[pos] != NVS_NAMECNT_ID) {
+		pos = (pos + 1) & SETTINGS_NVS_INDEX_MASK;
+	}
+
+	cf->index_hash[pos] = name_hash;
+	cf->index_id[pos] = name_id;
+	cf->index_used++;
+}
+
+static void settings_nvs_index_remove(struct settings_nvs *cf, uint32_t name_hash,
+				      uint16_t name_id)
+{
+	size_t pos = name_hash & SETTINGS_NVS_INDEX_MASK;
+	size_t next, home;
+
+	while (cf->index_id[pos] != name_id) {
+		if (cf->index_id[pos] == NVS_NAMECNT_ID) {
+			/* not indexed */
+			return;
+		}
+		pos = (pos + 1) & SETTINGS_NVS_INDEX_MASK;
+	}
+
+	/* Shift later entries of the probe sequence back into the hole */
+	next = pos;
+	while (true) {
+		next = (next + 1) & SETTINGS_NVS_INDEX_MASK;
+		if (cf->index_id[next] == NVS_NAMECNT_ID) {
+			break;
+		}
+
+		home = cf->index_hash[next] & SETTINGS_NVS_INDEX_MASK;
+		if (((next - home) & SETTINGS_NVS_INDEX_MASK) >=
+		    ((next - pos) & SETTINGS_NVS_INDEX_MASK)) {
+			cf->index_hash[pos] = cf->index_hash[next];
+			cf->index_id[pos] = cf->index_id[next];
+			pos = next;
+		}
+	}
+
+	cf->index_id[pos] = NVS_NAMECNT_ID;
+	cf->index_used--;
+}
+
+static void settings_nvs_index_build(struct settings_nvs *cf)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	uint16_t name_id;
+	ssize_t rc;
+
+	for (int i = 0; i < CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE; i++) {
+		cf->index_id[i] = NVS_NAMECNT_ID;
+	}
+	cf->index_used = 0;
+	cf->index_complete = true;
+	cf->free_name_id = cf->last_name_id + 1;
+
+	for (name_id = NVS_NAMECNT_ID + 1; name_id <= cf->last_name_id; name_id++) {
+		rc = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		if (rc <= 0) {
+			if (name_id < cf->free_name_id) {
+				cf->free_name_id = name_id;
+			}
+			continue;
+		}
+
+		name[rc] = '\0';
+		settings_nvs_index_add(cf, settings_nvs_name_hash(name), name_id);
+	}
+
+	LOG_DBG("Name index: %u names%s", cf->index_used,
+		cf->index_complete ? "" : " (incomplete)");
+}
+
+/* Find the lowest unused name ID, starting from the lowest ID that was freed */
+static uint16_t settings_nvs_index_free_id(struct settings_nvs *cf)
+{
+	char buf;
+
+	for (; cf->free_name_id <= cf->last_name_id; cf->free_name_id++) {
+		if (nvs_read(&cf->cf_nvs, cf->free_name_id, &buf, sizeof(buf)) == -ENOENT) {
+			return cf->free_name_id;
+		}
+	}
+
+	return cf->last_name_id + 1;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -179,6 +331,16 @@ static int settings_nvs_load(struct settings_store *cs,
 			 * or deleted. Clean dirty entries to make space for
 			 * future settings item.
 			 */
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			if (rc1 > 0) {
+				name[rc1] = '\0';
+				settings_nvs_index_remove(cf, settings_nvs_name_hash(name),
+							  name_id);
+			}
+			if (name_id < cf->free_name_id) {
+				cf->free_name_id = name_id;
+			}
+#endif
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
 
@@ -240,6 +402,24 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	uint32_t name_hash = settings_nvs_name_hash(name);
+
+	name_id = settings_nvs_index_find(cf, name, name_hash, rdname, sizeof(rdname));
+	if (name_id != NVS_NAMECNT_ID) {
+		write_name_id = name_id;
+		write_name = false;
+		goto found;
+	}
+
+	/* A complete index knows the name is not stored */
+	if (cf->index_complete) {
+		write_name_id = delete ? NVS_NAMECNT_ID : settings_nvs_index_free_id(cf);
+		write_name = true;
+		goto found;
+	}
+#endif
+
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
@@ -297,6 +477,13 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_remove(cf, name_hash, name_id);
+		if (name_id < cf->free_name_id) {
+			cf->free_name_id = name_id;
+		}
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -342,6 +529,15 @@ found:
 		}
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (write_name) {
+		settings_nvs_index_add(cf, name_hash, write_name_id);
+		if (write_name_id == cf->free_name_id) {
+			cf->free_name_id++;
+		}
+	}
+#endif
+
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	if (!name_in_cache) {
 		settings_nvs_cache_add(cf, name, write_name_id);
@@ -378,6 +574,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	settings_nvs_index_build(cf);
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
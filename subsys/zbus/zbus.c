@@ -119,7 +119,16 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 	return 0;
 }
 
-static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t end_time)
+/* Subscribers read the message from the channel, which a publication by reference does not
+ * update, so they are not notified of it.
+ */
+static inline bool _zbus_obs_skips_buf(const struct zbus_observer *obs, struct net_buf *msg_buf)
+{
+	return (msg_buf != NULL) && (obs->type == ZBUS_OBSERVER_SUBSCRIBER_TYPE);
+}
+
+static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t end_time,
+				  struct net_buf *msg_buf)
 {
 	int err = 0;
 	int last_error = 0;
@@ -130,13 +139,20 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 	struct zbus_channel_observation_mask *observation_mask;
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
-	buf = _zbus_create_net_buf(&_zbus_msg_subscribers_pool, zbus_chan_msg_size(chan),
-				   sys_timepoint_timeout(end_time));
+	if (msg_buf != NULL) {
+		/* Published by reference, message subscribers share its data */
+		buf = net_buf_ref(msg_buf);
+	} else {
+		buf = _zbus_create_net_buf(&_zbus_msg_subscribers_pool, zbus_chan_msg_size(chan),
+					   sys_timepoint_timeout(end_time));
 
-	_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
-				  "unavailable or heap is full");
+		_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
+					  "unavailable or heap is full");
 
-	net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+		net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+	}
+#else
+	ARG_UNUSED(msg_buf);
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 	LOG_DBG("Notifing %s's observers. Starting VDED:", _ZBUS_CHAN_NAME(chan));
@@ -156,6 +172,10 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 			continue;
 		}
 
+		if (_zbus_obs_skips_buf(obs, msg_buf)) {
+			continue;
+		}
+
 		err = _zbus_notify_observer(chan, obs, end_time, buf);
 
 		if (err) {
@@ -181,7 +201,7 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 
 		const struct zbus_observer *obs = obs_nd->obs;
 
-		if (!obs->data->enabled) {
+		if (!obs->data->enabled || _zbus_obs_skips_buf(obs, msg_buf)) {
 			continue;
 		}
 
@@ -369,13 +389,78 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 
 	memcpy(chan->message, msg, chan->message_size);
 
-	err = _zbus_vded_exec(chan, end_time);
+	err = _zbus_vded_exec(chan, end_time, NULL);
+
+	chan_unlock(chan, context_priority);
+
+	return err;
+}
+
+#if defined(CONFIG_ZBUS_MSG_ZERO_COPY)
+
+struct net_buf *zbus_chan_buf_alloc(const struct zbus_channel *chan, k_timeout_t timeout)
+{
+	__ASSERT(chan != NULL, "chan is required");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	struct net_buf *buf = _zbus_create_net_buf(&_zbus_msg_subscribers_pool,
+						   zbus_chan_msg_size(chan), timeout);
+
+	if (buf != NULL) {
+		net_buf_add(buf, zbus_chan_msg_size(chan));
+	}
+
+	return buf;
+}
+
+int zbus_chan_pub_buf(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(buf->len == chan->message_size, "buf must hold exactly one message");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	if (chan->validator != NULL && !chan->validator(buf->data, buf->len)) {
+		net_buf_unref(buf);
+
+		return -ENOMSG;
+	}
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+	err = chan_lock(chan, timeout, &context_priority);
+	if (err) {
+		net_buf_unref(buf);
+
+		return err;
+	}
+
+	/* Exposed to listeners for the duration of the notification only */
+	chan->data->msg_buf = buf;
+
+	err = _zbus_vded_exec(chan, end_time, buf);
+
+	chan->data->msg_buf = NULL;
 
 	chan_unlock(chan, context_priority);
 
+	net_buf_unref(buf);
+
 	return err;
 }
 
+#endif /* CONFIG_ZBUS_MSG_ZERO_COPY */
+
 int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeout)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
@@ -416,7 +501,7 @@ int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
-	err = _zbus_vded_exec(chan, end_time);
+	err = _zbus_vded_exec(chan, end_time, NULL);
 
 	chan_unlock(chan, context_priority);
 
@@ -489,6 +574,32 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+#if defined(CONFIG_ZBUS_MSG_ZERO_COPY)
+
+int zbus_sub_wait_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+		      struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_buf cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	*buf = net_buf_get(sub->message_fifo, timeout);
+
+	if (*buf == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(*buf));
+
+	return 0;
+}
+
+#endif /* CONFIG_ZBUS_MSG_ZERO_COPY */
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
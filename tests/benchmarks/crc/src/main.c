@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+
+#define MAX_LEN (16 * 1024)
+#define MIN_BYTES (256 * 1024)
+
+static uint8_t buf[MAX_LEN];
+
+static volatile uint32_t sink;
+
+static const char *variant(void)
+{
+	if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_8)) {
+		return "slice-by-8";
+	} else if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_4)) {
+		return "slice-by-4";
+	} else {
+		return "nibble";
+	}
+}
+
+static void report(const char *name, size_t len, uint32_t iters, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+	/* Hundredths of MB/s, i.e. bytes per ns times 10^5 */
+	uint32_t mbps = ns ? (uint32_t)(((uint64_t)len * iters * 100000U) / ns) : 0;
+
+	printk("%-10s %5zu bytes: %8u cycles %5u.%02u MB/s\n", name, len, cycles / iters,
+	       mbps / 100U, mbps % 100U);
+}
+
+static void run(size_t len)
+{
+	/* Process at least MIN_BYTES per measurement to even out timer
+	 * granularity on small buffers
+	 */
+	uint32_t iters = MAX(MIN_BYTES / len, 1);
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < iters; i++) {
+		sink = crc32_ieee(buf, len);
+	}
+	cycles = k_cycle_get_32() - start;
+	report("crc32_ieee", len, iters, cycles);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < iters; i++) {
+		sink = crc32_c(0, buf, len, true, true);
+	}
+	cycles = k_cycle_get_32() - start;
+	report("crc32_c", len, iters, cycles);
+}
+
+int main(void)
+{
+	static const size_t sizes[] = { 64, 1024, MAX_LEN };
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	printk("CRC32 benchmark: %s tables, hw accel %s\n", variant(),
+	       IS_ENABLED(CONFIG_CRC32_HW_ACCEL) ? "allowed" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run(sizes[i]);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This is a kernel heap benchmark. Heap blocks are often freed by another
+ * thread than the one which allocated them, for example buffers handed
+ * from a driver to a protocol thread, and their sizes vary. Both patterns
+ * are measured for a growing number of threads, with sizes spread over
+ * the cached size classes and a few larger ones:
+ *
+ * - local: each thread allocates a few blocks and frees them again.
+ * - remote: pairs of threads pass blocks through a message queue, the
+ *   producer allocating them and the consumer freeing them, pinned to
+ *   different CPUs when possible.
+ *
+ * With several CPUs the threads run in parallel and contend on the heap.
+ * It reports the rate at which blocks are allocated and freed and the
+ * average cost of one allocation and free.
+ */
+
+#define N_ROUNDS    4096
+#define BATCH       4
+#define MAX_THREADS 4
+#define MAX_PAIRS   (MAX_THREADS / 2)
+#define QUEUE_DEPTH 16
+#define HEAP_SIZE   (32 * 1024)
+#define STACK_SIZE  1024
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+
+/* All but the last one fit in the default cached size classes */
+static const uint16_t sizes[] = { 24, 64, 16, 200, 40, 128, 96, 512 };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_SEM_DEFINE(done, 0, MAX_THREADS);
+
+static char __aligned(4) queue_buf[MAX_PAIRS][QUEUE_DEPTH * sizeof(void *)];
+static struct k_msgq queues[MAX_PAIRS];
+
+static void local_worker(void *p1, void *p2, void *p3)
+{
+	unsigned int seed = POINTER_TO_UINT(p1);
+	void *blocks[BATCH];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			size_t size = sizes[(seed + i + j) % ARRAY_SIZE(sizes)];
+
+			blocks[j] = k_heap_alloc(&bench_heap, size, K_FOREVER);
+		}
+
+		for (int j = 0; j < BATCH; j++) {
+			k_heap_free(&bench_heap, blocks[j]);
+		}
+	}
+
+	k_sem_give(&done);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *queue = p1;
+	unsigned int seed = POINTER_TO_UINT(p2);
+	void *block;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS * BATCH; i++) {
+		block = k_heap_alloc(&bench_heap, sizes[(seed + i) % ARRAY_SIZE(sizes)],
+				     K_FOREVER);
+		(void)k_msgq_put(queue, &block, K_FOREVER);
+	}
+
+	k_sem_give(&done);
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *queue = p1;
+	void *block;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS * BATCH; i++) {
+		(void)k_msgq_get(queue, &block, K_FOREVER);
+		k_heap_free(&bench_heap, block);
+	}
+
+	k_sem_give(&done);
+}
+
+static void create(unsigned int i, k_thread_entry_t entry, void *p1, void *p2)
+{
+	k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry, p1, p2,
+			NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#if defined(CONFIG_SCHED_CPU_MASK)
+	(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+#endif
+}
+
+/* Run the threads created, which allocate and free n_ops blocks overall */
+static void run(const char *name, unsigned int n_threads, uint32_t n_ops)
+{
+	uint32_t start, cycles;
+	uint64_t ops_per_sec = 0U;
+
+	start = k_cycle_get_32();
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_sem_take(&done, K_FOREVER);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	if (cycles > 0U) {
+		ops_per_sec = (uint64_t)n_ops * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	printk("%-6s threads %u ops/s %8u cycles/op %5u\n", name, n_threads,
+	       (uint32_t)ops_per_sec, cycles / n_ops);
+}
+
+static void run_local(unsigned int n_threads)
+{
+	for (unsigned int i = 0; i < n_threads; i++) {
+		create(i, local_worker, UINT_TO_POINTER(i), NULL);
+	}
+
+	run("local", n_threads, n_threads * N_ROUNDS * BATCH);
+}
+
+static void run_remote(unsigned int n_pairs)
+{
+	/* Consumers get the odd threads, so pairs are split over two CPUs */
+	for (unsigned int i = 0; i < n_pairs; i++) {
+		k_msgq_init(&queues[i], queue_buf[i], sizeof(void *), QUEUE_DEPTH);
+		create(2 * i, producer, &queues[i], UINT_TO_POINTER(i));
+		create(2 * i + 1, consumer, &queues[i], NULL);
+	}
+
+	run("remote", 2 * n_pairs, n_pairs * N_ROUNDS * BATCH);
+}
+
+int main(void)
+{
+	printk("Kernel heap benchmark, %u cpus, %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_K_HEAP_CPU_CACHE) ? "per-CPU caches" : "no caches");
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		run_local(n);
+	}
+
+	for (unsigned int n = 1; n <= MAX_PAIRS; n *= 2) {
+		run_remote(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(log_smp_bench, LOG_LEVEL_INF);
+
+/* This is a deferred logging benchmark for SMP systems.  For each
+ * count N of CPUs, it starts N threads which all log as fast as they
+ * can.  Each thread times its own burst of log calls and the average
+ * cost of one call over all threads is reported, together with the
+ * number of messages dropped because the log buffer was full.  The
+ * log processing thread is set to the lowest application priority in
+ * prj.conf so it only catches up between bursts, which is the worst
+ * case for buffer contention.
+ */
+
+#define N_LOGS 500
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PRIO 5
+
+static atomic_t n_processed;
+static atomic_t n_dropped;
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+
+	atomic_inc(&n_processed);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	atomic_add(&n_dropped, cnt);
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static uint32_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(start_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void logger_fn(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t id = POINTER_TO_UINT(arg1);
+	uint32_t start;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < N_LOGS; i++) {
+		LOG_INF("thread %u msg %u", id, i);
+	}
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void wait_processed(uint32_t total)
+{
+	/* Every message is either processed or reported as dropped */
+	for (int i = 0; i < 500; i++) {
+		if ((atomic_get(&n_processed) + atomic_get(&n_dropped)) >= total) {
+			return;
+		}
+		k_msleep(10);
+	}
+}
+
+static void run(unsigned int n_threads)
+{
+	uint64_t cycles_tot = 0U;
+	uint32_t total = n_threads * N_LOGS;
+
+	atomic_clear(&n_processed);
+	atomic_clear(&n_dropped);
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger_fn,
+				UINT_TO_POINTER(i), NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+
+	/* Release all threads at once */
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		cycles_tot += cycles[i];
+	}
+
+	wait_processed(total);
+
+	printk("cpus %2u cycles %6u dropped %5u/%u\n", n_threads,
+	       (uint32_t)(cycles_tot / total), (uint32_t)atomic_get(&n_dropped),
+	       total);
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	printk("SMP logging benchmark: %u CPUs, per-CPU buffers %s\n", num_cpus,
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "on" : "off");
+
+	/* Keep main out of the way of the loggers while they run */
+	k_thread_priority_set(k_current_get(), PRIO - 1);
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		run(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This is a memory slab benchmark. Unlike a heap, a memory slab has a
+ * fixed number of blocks, and slabs are often sized for the worst case of
+ * their users, so blocks held by the per-CPU caches may be missing to
+ * another CPU. For a growing number of threads, each one allocates a few
+ * blocks from a shared memory slab and frees them again, a fixed number of
+ * times, first with a memory slab four times larger than what the threads
+ * hold at most, then with one exactly that large. With several CPUs the
+ * threads run in parallel and contend on the memory slab. It reports the
+ * rate at which blocks are allocated and freed, the average cost of one
+ * allocation and free, and how many allocations found no free block
+ * without waiting.
+ */
+
+#define N_ROUNDS    4096
+#define BATCH       4
+#define MAX_THREADS 4
+#define MAX_BLOCKS  (MAX_THREADS * BATCH * 4)
+#define BLOCK_SIZE  64
+#define STACK_SIZE  1024
+
+static char __aligned(4) slab_buf[MAX_BLOCKS * BLOCK_SIZE];
+static struct k_mem_slab bench_slab;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_SEM_DEFINE(done, 0, MAX_THREADS);
+static atomic_t waits;
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	void *blocks[BATCH];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			if (k_mem_slab_alloc(&bench_slab, &blocks[j], K_NO_WAIT) != 0) {
+				atomic_inc(&waits);
+				(void)k_mem_slab_alloc(&bench_slab, &blocks[j], K_FOREVER);
+			}
+		}
+
+		for (int j = 0; j < BATCH; j++) {
+			k_mem_slab_free(&bench_slab, blocks[j]);
+		}
+	}
+
+	k_sem_give(&done);
+}
+
+static void run(const char *name, unsigned int n_threads, uint32_t n_blocks)
+{
+	uint32_t start, cycles, n_ops;
+	uint64_t ops_per_sec = 0U;
+
+	(void)k_mem_slab_init(&bench_slab, slab_buf, BLOCK_SIZE, n_blocks);
+	atomic_clear(&waits);
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#if defined(CONFIG_SCHED_CPU_MASK)
+		(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+#endif
+	}
+
+	start = k_cycle_get_32();
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_sem_take(&done, K_FOREVER);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	n_ops = n_threads * N_ROUNDS * BATCH;
+
+	if (cycles > 0U) {
+		ops_per_sec = (uint64_t)n_ops * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	printk("%-5s threads %u ops/s %8u cycles/op %5u waits %3u%%\n", name,
+	       n_threads, (uint32_t)ops_per_sec, cycles / n_ops,
+	       (uint32_t)((uint64_t)atomic_get(&waits) * 100U / n_ops));
+}
+
+int main(void)
+{
+	printk("Memory slab benchmark, %u cpus, %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE) ? "per-CPU caches" : "no caches");
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		run("ample", n, MAX_BLOCKS);
+	}
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		run("tight", n, n * BATCH);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* This is a message queue benchmark. It sends a fixed number of batches of
+ * small messages to a message queue and receives them again, first one
+ * message per call, then one batch per call, then building the messages in
+ * place in the queue. It reports the average cost of sending and receiving
+ * one message in each case.
+ */
+
+#define N_ROUNDS 1024
+#define BATCH    16
+
+struct sample {
+	uint32_t timestamp;
+	int16_t channel[2];
+};
+
+K_MSGQ_DEFINE(bench_msgq, sizeof(struct sample), BATCH, 4);
+
+static struct sample tx[BATCH];
+static struct sample rx[BATCH];
+
+static void fill(struct sample *s, uint32_t i)
+{
+	s->timestamp = i;
+	s->channel[0] = (int16_t)i;
+	s->channel[1] = (int16_t)-i;
+}
+
+static void put_get(void)
+{
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			fill(&tx[j], j);
+			(void)k_msgq_put(&bench_msgq, &tx[j], K_NO_WAIT);
+		}
+
+		for (int j = 0; j < BATCH; j++) {
+			(void)k_msgq_get(&bench_msgq, &rx[j], K_NO_WAIT);
+		}
+	}
+}
+
+static void put_get_many(void)
+{
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			fill(&tx[j], j);
+		}
+
+		(void)k_msgq_put_many(&bench_msgq, tx, BATCH, K_NO_WAIT);
+		(void)k_msgq_get_many(&bench_msgq, rx, BATCH, K_NO_WAIT);
+	}
+}
+
+static void reserve_commit(void)
+{
+	void *msg;
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			if (k_msgq_put_reserve(&bench_msgq, &msg) == 0) {
+				fill(msg, j);
+				(void)k_msgq_put_commit(&bench_msgq);
+			}
+		}
+
+		(void)k_msgq_get_many(&bench_msgq, rx, BATCH, K_NO_WAIT);
+	}
+}
+
+static void run(const char *name, void (*fn)(void))
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	fn();
+	cycles = k_cycle_get_32() - start;
+
+	if (k_msgq_num_used_get(&bench_msgq) != 0U) {
+		printk("%s: messages left in queue\n", name);
+	}
+
+	printk("%-17s cycles/msg %5u\n", name, cycles / (N_ROUNDS * BATCH));
+}
+
+int main(void)
+{
+	printk("Message queue benchmark, %zu byte messages, batches of %u\n",
+	       sizeof(struct sample), BATCH);
+
+	run("put/get", put_get);
+	run("put_many/get_many", put_get_many);
+	run("reserve/commit", reserve_commit);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/buf.h>
+
+/* This is a network buffer pool benchmark. For a growing number of
+ * threads, each one allocates a few buffers from a shared pool and frees
+ * them again, a fixed number of times. With several CPUs the threads run
+ * in parallel and contend on the pool. It reports the rate at which
+ * buffers are allocated and freed, the average cost of one allocation and
+ * free, and how many allocations were served from a per-CPU cache.
+ */
+
+#define N_ROUNDS    4096
+#define BATCH       4
+#define MAX_THREADS 4
+#define BUF_SIZE    128
+#define STACK_SIZE  1024
+
+NET_BUF_POOL_FIXED_DEFINE(bench_pool, MAX_THREADS * BATCH * 2, BUF_SIZE, 4, NULL);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_SEM_DEFINE(done, 0, MAX_THREADS);
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	struct net_buf *bufs[BATCH];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (int j = 0; j < BATCH; j++) {
+			bufs[j] = net_buf_alloc(&bench_pool, K_FOREVER);
+		}
+
+		for (int j = 0; j < BATCH; j++) {
+			net_buf_unref(bufs[j]);
+		}
+	}
+
+	k_sem_give(&done);
+}
+
+static void run(unsigned int n_threads)
+{
+	struct net_buf_pool_stats stats;
+	uint32_t start, cycles, n_ops;
+	uint64_t ops_per_sec = 0U;
+
+	net_buf_pool_stats_reset(&bench_pool);
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#if defined(CONFIG_SCHED_CPU_MASK)
+		(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+#endif
+	}
+
+	start = k_cycle_get_32();
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_sem_take(&done, K_FOREVER);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (unsigned int i = 0; i < n_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	n_ops = n_threads * N_ROUNDS * BATCH;
+
+	if (cycles > 0U) {
+		ops_per_sec = (uint64_t)n_ops * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	net_buf_pool_stats_get(&bench_pool, &stats);
+
+	printk("threads %u ops/s %8u cycles/op %5u hits %3u%%\n", n_threads,
+	       (uint32_t)ops_per_sec, cycles / n_ops,
+	       (uint32_t)((uint64_t)stats.cache_hits * 100U / MAX(stats.allocs, 1U)));
+}
+
+int main(void)
+{
+	printk("Network buffer pool benchmark, %u cpus, %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_NET_BUF_POOL_CPU_CACHE) ? "per-CPU caches" : "no caches");
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		run(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
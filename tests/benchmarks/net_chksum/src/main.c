@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+
+/* This is an Internet checksum benchmark. For a range of packet sizes it
+ * sums a buffer a fixed number of times with calc_chksum(), the function
+ * behind all the checksums of the IP stack, and reports the average cost
+ * of one checksum and the resulting throughput. It then compares updating
+ * the checksum of a full sized segment after its acknowledgment number has
+ * changed, by summing the segment again and incrementally as in RFC 1624.
+ */
+
+#define N_ROUNDS 1024
+#define MAX_LEN  4096
+#define SEG_LEN  1500
+
+static const uint16_t lengths[] = { 20, 64, 128, 256, 512, 1024, 1500, MAX_LEN };
+
+static uint8_t data[MAX_LEN] __aligned(4);
+static volatile uint16_t sink;
+
+static void run(size_t len)
+{
+	uint32_t start, cycles;
+	uint64_t mb_per_sec = 0U;
+	uint16_t sum = 0U;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_ROUNDS; i++) {
+		sum += calc_chksum(sum, data, len);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	sink = sum;
+
+	if (cycles > 0U) {
+		mb_per_sec = (uint64_t)len * N_ROUNDS * sys_clock_hw_cycles_per_sec() /
+			     cycles / 1000000U;
+	}
+
+	printk("len %4u cycles %6u MB/s %5u\n", (unsigned int)len, cycles / N_ROUNDS,
+	       (uint32_t)mb_per_sec);
+}
+
+static void run_update(void)
+{
+	uint32_t start, full, incremental;
+	uint32_t ack, new_ack;
+	uint16_t chksum = htons(~calc_chksum(0, data, SEG_LEN));
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_ROUNDS; i++) {
+		new_ack = htonl(i);
+		memcpy(&data[8], &new_ack, sizeof(new_ack));
+		chksum = htons(~calc_chksum(0, data, SEG_LEN));
+	}
+	full = k_cycle_get_32() - start;
+
+	sink = chksum;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_ROUNDS; i++) {
+		memcpy(&ack, &data[8], sizeof(ack));
+		new_ack = htonl(i);
+		memcpy(&data[8], &new_ack, sizeof(new_ack));
+		chksum = net_chksum_update32(chksum, ack, new_ack);
+	}
+	incremental = k_cycle_get_32() - start;
+
+	sink = chksum;
+
+	printk("update full %6u incremental %6u\n", full / N_ROUNDS, incremental / N_ROUNDS);
+}
+
+int main(void)
+{
+	printk("Checksum benchmark, %s\n",
+	       IS_ENABLED(CONFIG_NET_CHKSUM_SIMD) ? "vector" : "scalar");
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(lengths); i++) {
+		run(lengths[i]);
+	}
+
+	run_update();
+
+	printk("fin\n");
+	return 0;
+}
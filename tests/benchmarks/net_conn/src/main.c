@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* This is a connection lookup benchmark.  For each count N of connected
+ * UDP connections (each one with its own remote port, next to a single
+ * unconnected listener), it feeds a fixed number of packets to a dummy
+ * interface, spread evenly over the N connections, and reports the rate
+ * at which they are received and the average cost of one packet.  The
+ * packets are processed in the context of the sender, so the time spent
+ * finding the connection is measured together with the rest of the
+ * input path.
+ */
+
+#define N_PKTS      4096
+#define MAX_CONNS   128
+#define LOCAL_PORT  4242
+#define REMOTE_PORT 10000
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handles[MAX_CONNS];
+static struct net_conn_handle *listener;
+static uint32_t n_received;
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_conn_bench, "net_conn_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static enum net_verdict recv_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	n_received++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static int conn_register(uint16_t remote_port, struct net_conn_handle **handle)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = local_addr,
+	};
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = remote_addr,
+	};
+
+	return net_conn_register(IPPROTO_UDP, AF_INET,
+				 remote_port != 0U ? (struct sockaddr *)&remote : NULL,
+				 (struct sockaddr *)&local, remote_port, LOCAL_PORT,
+				 NULL, recv_cb, NULL, handle);
+}
+
+static void send_pkt(struct net_if *iface, uint16_t remote_port)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, AF_INET, IPPROTO_UDP, K_FOREVER);
+
+	if (net_ipv4_create(pkt, &remote_addr, &local_addr) ||
+	    net_udp_create(pkt, htons(remote_port), htons(LOCAL_PORT))) {
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	if (net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static void run(struct net_if *iface, unsigned int n_conns)
+{
+	uint32_t start, cycles;
+	uint64_t pkts_per_sec = 0U;
+
+	n_received = 0U;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_PKTS; i++) {
+		send_pkt(iface, REMOTE_PORT + (i % n_conns));
+	}
+	cycles = k_cycle_get_32() - start;
+
+	if (cycles > 0U) {
+		pkts_per_sec = (uint64_t)n_received * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	printk("conns %3u pkts/s %8u cycles/pkt %6u lost %u\n", n_conns,
+	       (uint32_t)pkts_per_sec, cycles / N_PKTS, N_PKTS - n_received);
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	unsigned int n_conns = 0U;
+
+	printk("Connection lookup benchmark, hash %s\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "on" : "off");
+
+	if (net_if_ipv4_addr_add(iface, &local_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot add IPv4 address\n");
+		return 0;
+	}
+
+	if (conn_register(0U, &listener) < 0) {
+		printk("Cannot register listener\n");
+		return 0;
+	}
+
+	for (unsigned int n = 1; n <= MAX_CONNS; n *= 2) {
+		for (; n_conns < n; n_conns++) {
+			if (conn_register(REMOTE_PORT + n_conns, &handles[n_conns]) < 0) {
+				printk("Cannot register connection %u\n", n_conns);
+				return 0;
+			}
+		}
+
+		run(iface, n);
+	}
+
+	for (unsigned int i = 0; i < n_conns; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+	(void)net_conn_unregister(listener);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* This is a receive packet steering benchmark.  For each count N of UDP
+ * flows (each one with its own remote port) it feeds a fixed number of
+ * packets to a dummy interface, spread evenly over the N flows, and waits
+ * until the connection callback has seen all of them.  The packets are
+ * queued to the RX threads of the stack, which verify the UDP checksum,
+ * so with steering enabled the flows are spread over several threads,
+ * and over several CPUs on SMP targets.  It reports the rate at which
+ * the packets are received and the average cost of one packet.
+ */
+
+#define N_PKTS      4096
+#define MAX_FLOWS   16
+#define PAYLOAD_LEN 1024
+#define LOCAL_PORT  4242
+#define REMOTE_PORT 10000
+
+#if defined(CONFIG_NET_RPS)
+#define N_QUEUES CONFIG_NET_RPS_QUEUE_COUNT
+#else
+#define N_QUEUES 1
+#endif
+
+static struct in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr remote_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handle;
+static atomic_t n_received;
+static K_SEM_DEFINE(done, 0, 1);
+
+static uint8_t payload[PAYLOAD_LEN];
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr), NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_rps_bench, "net_rps_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static enum net_verdict recv_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	net_pkt_unref(pkt);
+
+	if (atomic_inc(&n_received) == N_PKTS - 1) {
+		k_sem_give(&done);
+	}
+
+	return NET_OK;
+}
+
+static void send_pkt(struct net_if *iface, uint16_t remote_port)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, PAYLOAD_LEN, AF_INET, IPPROTO_UDP,
+					K_FOREVER);
+
+	if (net_ipv4_create(pkt, &remote_addr, &local_addr) ||
+	    net_udp_create(pkt, htons(remote_port), htons(LOCAL_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	if (net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static void run(struct net_if *iface, unsigned int n_flows)
+{
+	uint32_t start, cycles;
+	uint64_t pkts_per_sec = 0U;
+
+	atomic_clear(&n_received);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_PKTS; i++) {
+		send_pkt(iface, REMOTE_PORT + (i % n_flows));
+	}
+
+	if (k_sem_take(&done, K_SECONDS(10)) < 0) {
+		printk("flows %2u timeout, received %u\n", n_flows,
+		       (unsigned int)atomic_get(&n_received));
+		return;
+	}
+	cycles = k_cycle_get_32() - start;
+
+	if (cycles > 0U) {
+		pkts_per_sec = (uint64_t)N_PKTS * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	printk("flows %2u pkts/s %8u cycles/pkt %6u\n", n_flows,
+	       (uint32_t)pkts_per_sec, cycles / N_PKTS);
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = local_addr,
+	};
+
+	printk("Receive packet steering benchmark, %u queues, %u cpus\n",
+	       N_QUEUES, arch_num_cpus());
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)i;
+	}
+
+	if (net_if_ipv4_addr_add(iface, &local_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot add IPv4 address\n");
+		return 0;
+	}
+
+	if (net_conn_register(IPPROTO_UDP, AF_INET, NULL, (struct sockaddr *)&local,
+			      0, LOCAL_PORT, NULL, recv_cb, NULL, &handle) < 0) {
+		printk("Cannot register connection\n");
+		return 0;
+	}
+
+	for (unsigned int n = 1; n <= MAX_FLOWS; n *= 2) {
+		run(iface, n);
+	}
+
+	(void)net_conn_unregister(handle);
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/printk.h>
+
+/* This is an RTIO completion benchmark.  A test iodev completes the
+ * requests queued to it from a low priority thread as fast as it can,
+ * and a few multishot writes keep it busy for the whole run.  For each
+ * batch size the main thread, at a higher priority, handles a fixed
+ * number of completions and reports the rate at which they are handled,
+ * the average cost of one operation and how many times it was woken up.
+ * A batch of 1 waits for each completion with rtio_cqe_consume_block(),
+ * larger batches use rtio_cqe_wait() and rtio_cqe_consume_batch().
+ */
+
+#define N_OPS      4096
+#define N_INFLIGHT 4
+#define MAX_BATCH  16
+#define MAIN_PRIO  5
+#define DEV_PRIO   7
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+RTIO_DEFINE(r_bench, N_INFLIGHT, 2 * MAX_BATCH);
+
+static K_SEM_DEFINE(dev_sem, 0, K_SEM_MAX_LIMIT);
+
+static void bench_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev *iodev = (struct rtio_iodev *)iodev_sqe->sqe.iodev;
+
+	rtio_mpsc_push(&iodev->iodev_sq, &iodev_sqe->q);
+	k_sem_give(&dev_sem);
+}
+
+static const struct rtio_iodev_api bench_iodev_api = {
+	.submit = bench_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(bench_iodev, &bench_iodev_api, NULL);
+
+static void dev_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct rtio_mpsc_node *node;
+
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&dev_sem, K_FOREVER);
+
+		node = rtio_mpsc_pop(&bench_iodev.iodev_sq);
+		if (node != NULL) {
+			rtio_iodev_sqe_ok(CONTAINER_OF(node, struct rtio_iodev_sqe, q), 0);
+		}
+	}
+}
+
+K_THREAD_DEFINE(dev_id, STACK_SIZE, dev_fn, NULL, NULL, NULL, DEV_PRIO, 0, 0);
+
+static uint8_t tx_buf[16];
+
+static uint32_t consume(unsigned int batch)
+{
+	struct rtio_cqe *cqes[MAX_BATCH];
+	size_t count;
+
+	if (batch == 1) {
+		rtio_cqe_release(&r_bench, rtio_cqe_consume_block(&r_bench));
+		return 1;
+	}
+
+	(void)rtio_cqe_wait(&r_bench, batch, K_MSEC(10));
+	count = rtio_cqe_consume_batch(&r_bench, cqes, batch);
+	for (size_t i = 0; i < count; i++) {
+		rtio_cqe_release(&r_bench, cqes[i]);
+	}
+
+	return count;
+}
+
+static void run(unsigned int batch)
+{
+	struct rtio_sqe *handles[N_INFLIGHT];
+	struct rtio_cqe *cqe;
+	uint32_t done = 0U, wakeups = 0U;
+	uint32_t start, cycles;
+	uint64_t ops_per_sec = 0U;
+
+	for (int i = 0; i < N_INFLIGHT; i++) {
+		handles[i] = rtio_sqe_acquire(&r_bench);
+		rtio_sqe_prep_write_multishot(handles[i], &bench_iodev, RTIO_PRIO_NORM, tx_buf,
+					      sizeof(tx_buf), NULL);
+	}
+
+	start = k_cycle_get_32();
+	(void)rtio_submit(&r_bench, 0);
+	while (done < N_OPS) {
+		done += consume(batch);
+		wakeups++;
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < N_INFLIGHT; i++) {
+		(void)rtio_sqe_cancel(handles[i]);
+	}
+
+	/* Let the iodev retire the canceled requests and drop what is left */
+	k_msleep(10);
+	while ((cqe = rtio_cqe_consume(&r_bench)) != NULL) {
+		rtio_cqe_release(&r_bench, cqe);
+	}
+
+	if (cycles > 0U) {
+		ops_per_sec = (uint64_t)done * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	printk("batch %2u ops/s %8u cycles/op %6u wakeups %5u\n", batch, (uint32_t)ops_per_sec,
+	       cycles / done, wakeups);
+}
+
+int main(void)
+{
+	printk("RTIO completion benchmark\n");
+
+	k_thread_priority_set(k_current_get(), MAIN_PRIO);
+
+	for (unsigned int batch = 1; batch <= MAX_BATCH; batch *= 2) {
+		run(batch);
+	}
+
+	printk("fin\n");
+	return 0;
+}
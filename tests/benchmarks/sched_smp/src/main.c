@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+/* This is an SMP scheduler scaling benchmark.  For each count N of
+ * CPUs to keep busy, it starts N independent "ping"/"pong" thread
+ * pairs.  Ping gives the pong semaphore and waits on its own; pong
+ * does the reverse.  Every handoff is therefore one wakeup plus one
+ * context switch, and with N pairs running concurrently all CPUs hit
+ * the scheduler at the same time.  The per-handoff cost and the
+ * give-to-wake latency are averaged over all pairs and reported for
+ * each N, so the numbers can be compared between scheduler backends
+ * and with/without CONFIG_SCHED_PER_CPU_RUNQ.
+ */
+
+#define N_ITER   2000
+#define N_SETTLE 10
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define PRIO 5
+
+struct pair {
+	struct k_sem ping_sem;
+	struct k_sem pong_sem;
+	volatile uint32_t give_stamp;
+	uint64_t wakeup_tot;
+	uint32_t wakeup_n;
+	uint32_t start;
+	uint32_t end;
+};
+
+static struct pair pairs[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread ping_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread pong_threads[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(ping_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pong_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void ping_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ITER + N_SETTLE; i++) {
+		if (i == N_SETTLE) {
+			p->start = k_cycle_get_32();
+		}
+		p->give_stamp = k_cycle_get_32();
+		k_sem_give(&p->pong_sem);
+		k_sem_take(&p->ping_sem, K_FOREVER);
+	}
+	p->end = k_cycle_get_32();
+
+	k_sem_give(&done_sem);
+}
+
+static void pong_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ITER + N_SETTLE; i++) {
+		k_sem_take(&p->pong_sem, K_FOREVER);
+		if (i >= N_SETTLE) {
+			p->wakeup_tot += k_cycle_get_32() - p->give_stamp;
+			p->wakeup_n++;
+		}
+		k_sem_give(&p->ping_sem);
+	}
+}
+
+static void run(unsigned int n_pairs)
+{
+	uint64_t switch_tot = 0U, wakeup_tot = 0U, wakeup_n = 0U;
+
+	for (unsigned int i = 0; i < n_pairs; i++) {
+		struct pair *p = &pairs[i];
+
+		memset(p, 0, sizeof(*p));
+		k_sem_init(&p->ping_sem, 0, 1);
+		k_sem_init(&p->pong_sem, 0, 1);
+
+		k_thread_create(&pong_threads[i], pong_stacks[i], STACK_SIZE,
+				pong_fn, p, NULL, NULL, PRIO, 0, K_NO_WAIT);
+		k_thread_create(&ping_threads[i], ping_stacks[i], STACK_SIZE,
+				ping_fn, p, NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < n_pairs; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < n_pairs; i++) {
+		struct pair *p = &pairs[i];
+
+		k_thread_join(&pong_threads[i], K_FOREVER);
+		k_thread_join(&ping_threads[i], K_FOREVER);
+
+		switch_tot += p->end - p->start;
+		wakeup_tot += p->wakeup_tot;
+		wakeup_n += p->wakeup_n;
+	}
+
+	/* Two handoffs (ping->pong and pong->ping) per iteration */
+	printk("cpus %2u switch %6u wakeup %6u\n", n_pairs,
+	       (uint32_t)(switch_tot / (2U * N_ITER * n_pairs)),
+	       (uint32_t)(wakeup_tot / wakeup_n));
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	printk("SMP scheduler benchmark: %u CPUs, per-CPU run queues %s\n",
+	       num_cpus,
+	       IS_ENABLED(CONFIG_SCHED_PER_CPU_RUNQ) ? "on" : "off");
+
+	/* Run main above the pairs, so that all of them are created before
+	 * any starts. Main then only blocks waiting for them to finish.
+	 */
+	k_thread_priority_set(k_current_get(), PRIO - 1);
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		run(n);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/printk.h>
+
+#include "settings/settings_nvs.h"
+
+/* This is a settings NVS backend benchmark.  Settings are added to an
+ * empty partition one by one, and at a few checkpoints the cost of
+ * adding a setting, updating one, loading all of them and initializing
+ * the backend is measured.  See README.rst for the details.
+ */
+
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
+
+#define MAX_KEYS  512
+#define N_UPDATES 32
+
+static uint32_t n_loaded;
+static uint32_t rand_state;
+
+/* Flash read calls, counted by the flash simulator. On hardware only the
+ * times are reported.
+ */
+static uint32_t *flash_read_calls;
+static uint32_t no_reads;
+
+static int flash_read_calls_find(struct stats_hdr *hdr, void *arg,
+				 const char *name, uint16_t off)
+{
+	ARG_UNUSED(arg);
+
+	if (!strcmp(name, "flash_read_calls")) {
+		flash_read_calls = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static void flash_stats_init(void)
+{
+	struct stats_hdr *hdr = NULL;
+
+	if (IS_ENABLED(CONFIG_STATS_NAMES)) {
+		hdr = stats_group_find("flash_sim_stats");
+	}
+	if (hdr != NULL) {
+		stats_walk(hdr, flash_read_calls_find, NULL);
+	}
+	if (flash_read_calls == NULL) {
+		flash_read_calls = &no_reads;
+	}
+}
+
+static uint32_t next_rand(void)
+{
+	/* Simple LCG, good enough to pick keys */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	uint32_t val;
+
+	ARG_UNUSED(name);
+
+	if (read_cb(cb_arg, &val, MIN(len, sizeof(val))) < 0) {
+		return -EIO;
+	}
+	n_loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static int save_key(uint32_t key, uint32_t val)
+{
+	char name[24];
+
+	snprintf(name, sizeof(name), "bench/k%04u", key);
+	return settings_save_one(name, &val, sizeof(val));
+}
+
+int main(void)
+{
+	static const uint32_t checkpoints[] = { 32, 64, 128, 256, MAX_KEYS };
+	struct settings_nvs *cf;
+	const struct flash_area *fa;
+	void *storage;
+	uint32_t keys = 0;
+	uint32_t start, new_cyc, update_cyc, load_cyc, init_cyc;
+	uint32_t reads, new_rd, update_rd, load_rd, init_rd;
+	uint32_t prev;
+	int rc;
+
+	printk("Settings NVS benchmark (name %s, NVS %s)\n",
+	       IS_ENABLED(CONFIG_SETTINGS_NVS_NAME_INDEX) ? "index" :
+	       IS_ENABLED(CONFIG_SETTINGS_NVS_NAME_CACHE) ? "cache" : "scan",
+	       IS_ENABLED(CONFIG_NVS_ID_INDEX) ? "ID index" :
+	       IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE) ? "lookup cache" : "scan");
+
+	/* Start from an empty partition */
+	rc = flash_area_open(SETTINGS_PARTITION, &fa);
+	__ASSERT_NO_MSG(rc == 0);
+	rc = flash_area_erase(fa, 0, fa->fa_size);
+	__ASSERT_NO_MSG(rc == 0);
+
+	rc = settings_subsys_init();
+	if (rc) {
+		printk("settings_subsys_init failed: %d\n", rc);
+		return 0;
+	}
+
+	flash_stats_init();
+	settings_storage_get(&storage);
+	cf = CONTAINER_OF(storage, struct settings_nvs, cf_nvs);
+
+	for (int i = 0; i < ARRAY_SIZE(checkpoints); i++) {
+		prev = keys;
+
+		reads = *flash_read_calls;
+		start = k_cycle_get_32();
+		for (; keys < checkpoints[i]; keys++) {
+			rc = save_key(keys, keys);
+			__ASSERT(rc == 0, "save failed: %d", rc);
+		}
+		new_cyc = (k_cycle_get_32() - start) / (keys - prev);
+		new_rd = (*flash_read_calls - reads) / (keys - prev);
+
+		rand_state = keys;
+		reads = *flash_read_calls;
+		start = k_cycle_get_32();
+		for (int j = 0; j < N_UPDATES; j++) {
+			rc = save_key(next_rand() % keys, keys + j);
+			__ASSERT(rc == 0, "update failed: %d", rc);
+		}
+		update_cyc = (k_cycle_get_32() - start) / N_UPDATES;
+		update_rd = (*flash_read_calls - reads) / N_UPDATES;
+
+		n_loaded = 0;
+		reads = *flash_read_calls;
+		start = k_cycle_get_32();
+		rc = settings_load();
+		load_cyc = k_cycle_get_32() - start;
+		load_rd = *flash_read_calls - reads;
+		__ASSERT(rc == 0 && n_loaded == keys, "load failed: %d, %u", rc, n_loaded);
+
+		/* Re-initialize the backend as done at boot */
+		reads = *flash_read_calls;
+		start = k_cycle_get_32();
+		rc = settings_nvs_backend_init(cf);
+		init_cyc = k_cycle_get_32() - start;
+		init_rd = *flash_read_calls - reads;
+		__ASSERT(rc == 0, "backend init failed: %d", rc);
+
+		printk("keys %4u new %6u update %6u load %8u init %8u\n", keys,
+		       k_cyc_to_us_floor32(new_cyc), k_cyc_to_us_floor32(update_cyc),
+		       k_cyc_to_us_floor32(load_cyc), k_cyc_to_us_floor32(init_cyc));
+		printk("     reads new %6u update %6u load %8u init %8u\n",
+		       new_rd, update_rd, load_rd, init_rd);
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/ws_pool.h>
+
+/* This is a work-stealing thread pool benchmark. For pools with a growing
+ * number of workers, it runs the same CPU bound parallel for loop a fixed
+ * number of times. With several CPUs the workers run in parallel. It
+ * reports the rate at which loop iterations are done, the average cost of
+ * one iteration and how many jobs were stolen between workers.
+ */
+
+#define N_ROUNDS    16
+#define N_ITEMS     1024
+#define GRAIN       16
+#define WORK        256
+#define STACK_SIZE  1024
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+K_WS_POOL_DEFINE(pool1, 1, STACK_SIZE);
+K_WS_POOL_DEFINE(pool2, 2, STACK_SIZE);
+K_WS_POOL_DEFINE(pool4, 4, STACK_SIZE);
+
+static uint32_t items[N_ITEMS];
+
+static void scramble(uint32_t begin, uint32_t end, void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t x = items[i] + i + 1;
+
+		for (int j = 0; j < WORK; j++) {
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+		}
+
+		items[i] = x;
+	}
+}
+
+static void run(struct k_ws_pool *pool)
+{
+	struct k_ws_pool_stats stats;
+	uint32_t start, cycles, n_ops;
+	uint64_t ops_per_sec = 0U;
+
+	k_ws_pool_start(pool, WORKER_PRIO);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_ROUNDS; i++) {
+		k_ws_parallel_for(pool, 0, N_ITEMS, GRAIN, scramble, NULL);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	n_ops = N_ROUNDS * N_ITEMS;
+
+	if (cycles > 0U) {
+		ops_per_sec = (uint64_t)n_ops * sys_clock_hw_cycles_per_sec() / cycles;
+	}
+
+	k_ws_pool_stats_get(pool, &stats);
+
+	printk("threads %u ops/s %8u cycles/op %5u stolen %u\n", pool->num_workers,
+	       (uint32_t)ops_per_sec, cycles / n_ops, stats.stolen);
+}
+
+int main(void)
+{
+	printk("Work-stealing pool benchmark, %u cpus\n", arch_num_cpus());
+
+	run(&pool1);
+	run(&pool2);
+	run(&pool4);
+
+	printk("fin\n");
+	return 0;
+}
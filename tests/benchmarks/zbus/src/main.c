@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/zbus/zbus.h>
+
+/* This is a zbus message subscriber benchmark.  For every message size
+ * and number of message subscribers it publishes a burst of messages,
+ * first by copy and then by reference, and reports the average cost of
+ * one publication (until all subscribers received it) and the average
+ * latency between the publisher stamping a message and a subscriber
+ * getting hold of it.  Subscribers run at a higher priority than the
+ * publisher, so every publication is consumed right away.
+ */
+
+#define N_MSGS    200
+#define N_SUBS    4
+#define MAX_SIZE  4096
+#define SUB_PRIO  3
+#define PUB_PRIO  5
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct frame_hdr {
+	uint32_t stamp;
+};
+
+#define FRAME_CHAN_DEFINE(_size)                                                                   \
+	struct frame_##_size {                                                                     \
+		struct frame_hdr hdr;                                                              \
+		uint8_t payload[_size - sizeof(struct frame_hdr)];                                 \
+	};                                                                                         \
+	ZBUS_CHAN_DEFINE(chan_##_size, struct frame_##_size, NULL, NULL,                           \
+			 ZBUS_OBSERVERS(msub0, msub1, msub2, msub3), ZBUS_MSG_INIT(0))
+
+FRAME_CHAN_DEFINE(64);
+FRAME_CHAN_DEFINE(256);
+FRAME_CHAN_DEFINE(1024);
+FRAME_CHAN_DEFINE(4096);
+
+static const struct zbus_channel *const chans[] = {
+	&chan_64, &chan_256, &chan_1024, &chan_4096,
+};
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub0);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub2);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub3);
+
+static const struct zbus_observer *const subs[N_SUBS] = {
+	&msub0, &msub1, &msub2, &msub3,
+};
+
+static uint32_t __aligned(4) tx_frame[MAX_SIZE / sizeof(uint32_t)];
+static uint32_t __aligned(4) rx_frames[N_SUBS][MAX_SIZE / sizeof(uint32_t)];
+
+static volatile bool zero_copy;
+static uint32_t rx_count[N_SUBS];
+static uint64_t latency_tot[N_SUBS];
+
+static K_SEM_DEFINE(done_sem, 0, N_SUBS);
+
+static void sub_fn(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t idx = POINTER_TO_UINT(arg1);
+	const struct zbus_observer *sub = subs[idx];
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+	uint32_t stamp;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		if (zero_copy) {
+			if (zbus_sub_wait_buf(sub, &chan, &buf, K_FOREVER) != 0) {
+				continue;
+			}
+			stamp = ((const struct frame_hdr *)buf->data)->stamp;
+			net_buf_unref(buf);
+		} else {
+			if (zbus_sub_wait_msg(sub, &chan, rx_frames[idx], K_FOREVER) != 0) {
+				continue;
+			}
+			stamp = ((const struct frame_hdr *)rx_frames[idx])->stamp;
+		}
+
+		latency_tot[idx] += k_cycle_get_32() - stamp;
+		if (++rx_count[idx] == N_MSGS) {
+			k_sem_give(&done_sem);
+		}
+	}
+}
+
+K_THREAD_DEFINE(sub0_id, STACK_SIZE, sub_fn, UINT_TO_POINTER(0), NULL, NULL, SUB_PRIO, 0, 0);
+K_THREAD_DEFINE(sub1_id, STACK_SIZE, sub_fn, UINT_TO_POINTER(1), NULL, NULL, SUB_PRIO, 0, 0);
+K_THREAD_DEFINE(sub2_id, STACK_SIZE, sub_fn, UINT_TO_POINTER(2), NULL, NULL, SUB_PRIO, 0, 0);
+K_THREAD_DEFINE(sub3_id, STACK_SIZE, sub_fn, UINT_TO_POINTER(3), NULL, NULL, SUB_PRIO, 0, 0);
+
+static void publish(const struct zbus_channel *chan)
+{
+	if (zero_copy) {
+		struct net_buf *buf = zbus_chan_buf_alloc(chan, K_FOREVER);
+
+		((struct frame_hdr *)buf->data)->stamp = k_cycle_get_32();
+		(void)zbus_chan_pub_buf(chan, buf, K_FOREVER);
+	} else {
+		((struct frame_hdr *)tx_frame)->stamp = k_cycle_get_32();
+		(void)zbus_chan_pub(chan, tx_frame, K_FOREVER);
+	}
+}
+
+static void run(const struct zbus_channel *chan, unsigned int n_subs, bool by_ref)
+{
+	uint64_t latency = 0U;
+	uint32_t start, cycles;
+
+	for (unsigned int i = 0; i < N_SUBS; i++) {
+		rx_count[i] = 0U;
+		latency_tot[i] = 0U;
+		(void)zbus_obs_set_chan_notification_mask(subs[i], chan, i >= n_subs);
+	}
+	zero_copy = by_ref;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < N_MSGS; i++) {
+		publish(chan);
+	}
+	for (unsigned int i = 0; i < n_subs; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+	cycles = (k_cycle_get_32() - start) / N_MSGS;
+
+	for (unsigned int i = 0; i < n_subs; i++) {
+		latency += latency_tot[i];
+	}
+
+	printk("%-9s size %4u obs %u cycles %7u latency %7u\n", by_ref ? "zero-copy" : "copy",
+	       (uint32_t)zbus_chan_msg_size(chan), n_subs, cycles,
+	       (uint32_t)(latency / (n_subs * N_MSGS)));
+}
+
+int main(void)
+{
+	printk("Zbus message subscriber benchmark\n");
+
+	k_thread_priority_set(k_current_get(), PUB_PRIO);
+
+	for (int c = 0; c < ARRAY_SIZE(chans); c++) {
+		for (unsigned int n = 1; n <= N_SUBS; n++) {
+			run(chans[c], n, false);
+			run(chans[c], n, true);
+		}
+	}
+
+	printk("fin\n");
+	return 0;
+}
@@ -265,3 +265,52 @@ ZTEST(k_heap_api, test_k_heap_alloc_pending_null)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Validate the per-CPU caches of small blocks
+ *
+ * @details A small block freed on a CPU is handed out again by the next
+ * allocation of the same size class. Blocks held in the caches must not
+ * make a larger allocation fail once they have all been freed.
+ *
+ * @ingroup kernel_heap_tests
+ */
+ZTEST(k_heap_api, test_k_heap_cpu_cache)
+{
+	static void *blocks[HEAP_SIZE / 16];
+	int n = 0;
+	char *p, *q;
+
+	if (!IS_ENABLED(CONFIG_K_HEAP_CPU_CACHE)) {
+		ztest_test_skip();
+	}
+
+	p = k_heap_alloc(&k_heap_test, 24, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_test, p);
+
+	q = k_heap_alloc(&k_heap_test, 32, K_NO_WAIT);
+	zassert_equal(p, q, "cached block not reused");
+	k_heap_free(&k_heap_test, q);
+
+	/* Exhaust the heap with small blocks, most of which end up in the
+	 * cache once freed.
+	 */
+	while (n < ARRAY_SIZE(blocks)) {
+		blocks[n] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (blocks[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+
+	zassert_true(n > 0 && n < ARRAY_SIZE(blocks), "unexpected block count %d", n);
+
+	while (n > 0) {
+		k_heap_free(&k_heap_test, blocks[--n]);
+	}
+
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks not returned to the heap");
+	k_heap_free(&k_heap_test, p);
+}
@@ -25,14 +25,15 @@ K_HEAP_DEFINE(test_pool, MAX_SZ * 2);
 
 extern struct k_msgq kmsgq;
 extern struct k_msgq msgq;
+extern struct k_msgq many_msgq;
 extern struct k_sem end_sema;
 extern struct k_thread tdata;
 K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
 
 void *msgq_api_setup(void)
 {
-	k_thread_access_grant(k_current_get(), &kmsgq, &msgq, &end_sema,
-			      &tdata, &tstack);
+	k_thread_access_grant(k_current_get(), &kmsgq, &msgq, &many_msgq,
+			      &end_sema, &tdata, &tstack);
 	k_thread_heap_assign(k_current_get(), &test_pool);
 	return NULL;
 }
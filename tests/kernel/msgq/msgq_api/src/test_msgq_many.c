@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 4
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+K_MSGQ_DEFINE(many_msgq, MSG_SIZE, MANY_LEN, 4);
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MANY_LEN];
+static ZTEST_DMEM uint32_t tx[2 * MANY_LEN];
+static uint32_t thread_rx;
+static int thread_ret;
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_msgq_get((struct k_msgq *)p1, &thread_rx, K_FOREVER);
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = MSG1;
+
+	k_msleep(TIMEOUT_MS >> 1);
+	thread_ret = k_msgq_put((struct k_msgq *)p1, &msg, K_NO_WAIT);
+}
+
+static void start_thread(k_thread_entry_t entry)
+{
+	k_thread_create(&tdata, tstack, STACK_SIZE, entry, &msgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+static void init_msgq(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MANY_LEN);
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages at once
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_get_many)
+{
+	uint32_t rx[2 * MANY_LEN];
+
+	init_msgq();
+
+	zassert_equal(k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT), 3);
+	zassert_equal(k_msgq_get_many(&msgq, rx, 2, K_NO_WAIT), 2);
+	zassert_equal(rx[0], tx[0]);
+	zassert_equal(rx[1], tx[1]);
+
+	/**TESTPOINT: only the messages that fit are sent, wrapping around */
+	zassert_equal(k_msgq_put_many(&msgq, &tx[3], 5, K_NO_WAIT), 3);
+	zassert_equal(k_msgq_num_used_get(&msgq), MANY_LEN);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 1, TIMEOUT), -EAGAIN);
+
+	/**TESTPOINT: only the queued messages are received, in order */
+	zassert_equal(k_msgq_get_many(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT),
+		      MANY_LEN);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(rx[i], tx[2 + i]);
+	}
+
+	zassert_equal(k_msgq_get_many(&msgq, rx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_many(&msgq, rx, 1, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_put_many(&msgq, tx, 0, K_NO_WAIT), 0);
+}
+
+/**
+ * @brief Test sending several messages to a waiting receiver
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_many_to_waiter)
+{
+	uint32_t rx[MANY_LEN];
+
+	init_msgq();
+
+	start_thread(get_entry);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the first message goes to the waiting thread */
+	zassert_equal(k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT), 3);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 0);
+	zassert_equal(thread_rx, tx[0]);
+
+	zassert_equal(k_msgq_get_many(&msgq, rx, MANY_LEN, K_NO_WAIT), 2);
+	zassert_equal(rx[0], tx[1]);
+	zassert_equal(rx[1], tx[2]);
+
+	/**TESTPOINT: an empty queue waits for one message */
+	start_thread(put_entry);
+	zassert_equal(k_msgq_get_many(&msgq, rx, MANY_LEN, K_FOREVER), 1);
+	zassert_equal(rx[0], MSG1);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 0);
+}
+
+/**
+ * @brief Test building messages in place in the queue
+ * @see k_msgq_put_reserve(), k_msgq_put_commit()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_reserve)
+{
+	uint32_t rx[MANY_LEN];
+	void *msg, *msg2;
+
+	init_msgq();
+
+	zassert_equal(k_msgq_put_commit(&msgq), -EINVAL);
+
+	zassert_ok(k_msgq_put_reserve(&msgq, &msg));
+	zassert_true((char *)msg >= tbuffer && (char *)msg < tbuffer + sizeof(tbuffer));
+	zassert_equal(k_msgq_put_reserve(&msgq, &msg2), -EBUSY);
+	zassert_equal(k_msgq_num_free_get(&msgq), MANY_LEN - 1);
+
+	/**TESTPOINT: the buffer cannot be released under a reservation */
+	zassert_equal(k_msgq_cleanup(&msgq), -EBUSY);
+
+	/**TESTPOINT: messages sent after a reservation are held back */
+	zassert_equal(k_msgq_put_many(&msgq, &tx[1], 2, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+	zassert_equal(k_msgq_num_free_get(&msgq), MANY_LEN - 3);
+	zassert_equal(k_msgq_get(&msgq, rx, K_NO_WAIT), -ENOMSG);
+
+	*(uint32_t *)msg = tx[0];
+	zassert_ok(k_msgq_put_commit(&msgq));
+	zassert_equal(k_msgq_get_many(&msgq, rx, MANY_LEN, K_NO_WAIT), 3);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rx[i], tx[i]);
+	}
+
+	/**TESTPOINT: a full queue cannot be reserved */
+	zassert_equal(k_msgq_put_many(&msgq, tx, MANY_LEN, K_NO_WAIT), MANY_LEN);
+	zassert_equal(k_msgq_put_reserve(&msgq, &msg), -ENOMSG);
+	k_msgq_purge(&msgq);
+
+	/**TESTPOINT: commit hands the message to a waiting thread */
+	start_thread(get_entry);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_ok(k_msgq_put_reserve(&msgq, &msg));
+	zassert_ok(k_msgq_put(&msgq, &tx[1], K_NO_WAIT));
+	*(uint32_t *)msg = tx[0];
+	zassert_ok(k_msgq_put_commit(&msgq));
+
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 0);
+	zassert_equal(thread_rx, tx[0]);
+	zassert_equal(k_msgq_get(&msgq, rx, K_NO_WAIT), 0);
+	zassert_equal(rx[0], tx[1]);
+
+	/**TESTPOINT: purge keeps the reserved message only */
+	zassert_ok(k_msgq_put_reserve(&msgq, &msg));
+	zassert_ok(k_msgq_put(&msgq, &tx[1], K_NO_WAIT));
+	k_msgq_purge(&msgq);
+	zassert_equal(k_msgq_num_free_get(&msgq), MANY_LEN - 1);
+	*(uint32_t *)msg = tx[2];
+	zassert_ok(k_msgq_put_commit(&msgq));
+	zassert_equal(k_msgq_get_many(&msgq, rx, MANY_LEN, K_NO_WAIT), 1);
+	zassert_equal(rx[0], tx[2]);
+}
+
+/**
+ * @brief Test sending and receiving several messages at once from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	uint32_t rx[2 * MANY_LEN];
+
+	k_msgq_purge(&many_msgq);
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+
+	/**TESTPOINT: only the messages that fit are sent */
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, ARRAY_SIZE(tx), K_NO_WAIT),
+		      MANY_LEN);
+	zassert_equal(k_msgq_put_many(&many_msgq, tx, 1, K_NO_WAIT), -ENOMSG);
+
+	/**TESTPOINT: messages are received in order, wrapping around */
+	zassert_equal(k_msgq_get_many(&many_msgq, rx, 3, K_NO_WAIT), 3);
+	zassert_equal(k_msgq_put_many(&many_msgq, &tx[MANY_LEN], 2, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_get_many(&many_msgq, &rx[3], ARRAY_SIZE(rx) - 3,
+				      K_NO_WAIT), 3);
+	for (int i = 0; i < 6; i++) {
+		zassert_equal(rx[i], tx[i]);
+	}
+
+	zassert_equal(k_msgq_get_many(&many_msgq, rx, 1, K_NO_WAIT), -ENOMSG);
+}
+
+/**
+ * @}
+ */
@@ -1442,6 +1442,100 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+#define SLACK_ITEMS 4
+#define SLACK_TICKS 16
+
+static struct k_work_delayable slack_dwork[SLACK_ITEMS];
+static k_ticks_t slack_expires[SLACK_ITEMS];
+static k_ticks_t slack_handled[SLACK_ITEMS];
+static struct k_sem slack_sem;
+
+static void slack_handler(struct k_work *work)
+{
+	struct k_work_delayable *one_dwork = k_work_delayable_from_work(work);
+	int i = one_dwork - slack_dwork;
+
+	slack_handled[i] = k_uptime_ticks();
+	k_sem_give(&slack_sem);
+}
+#endif
+
+/* Single CPU test that delays with overlapping slacks expire together */
+ZTEST(work_1cpu, test_1cpu_delayable_slack)
+{
+#ifdef CONFIG_WORK_DELAYABLE_SLACK
+	struct k_work_delayable_stats stats;
+	k_ticks_t now, first;
+	int rc;
+
+	k_sem_init(&slack_sem, 0, SLACK_ITEMS);
+	k_work_delayable_stats_reset();
+
+	/* Make the delays end on consecutive ticks just past a multiple of
+	 * the slack, which then all round up to the next multiple.
+	 */
+	k_sleep(K_TICKS(1));
+	now = k_uptime_ticks();
+	first = ROUND_UP(now + 2 * SLACK_TICKS, SLACK_TICKS) + 1;
+
+	for (int i = 0; i < SLACK_ITEMS; i++) {
+		k_work_init_delayable(&slack_dwork[i], slack_handler);
+		k_work_delayable_slack_set(&slack_dwork[i], K_TICKS(SLACK_TICKS));
+
+		slack_expires[i] = first + i;
+		rc = k_work_schedule_for_queue(&coophi_queue, &slack_dwork[i],
+					       K_TICKS(slack_expires[i] - now - 1));
+		zassert_equal(rc, 1);
+	}
+
+	for (int i = 0; i < SLACK_ITEMS; i++) {
+		rc = k_sem_take(&slack_sem, K_FOREVER);
+		zassert_equal(rc, 0);
+	}
+
+	for (int i = 0; i < SLACK_ITEMS; i++) {
+		zassert_true(slack_handled[i] >= slack_expires[i],
+			     "early %lld < %lld", (long long)slack_handled[i],
+			     (long long)slack_expires[i]);
+		zassert_true(slack_handled[i] <= slack_expires[i] + SLACK_TICKS,
+			     "late %lld > %lld", (long long)slack_handled[i],
+			     (long long)slack_expires[i]);
+	}
+
+	k_work_delayable_stats_get(&stats);
+	zassert_equal(stats.slacked, SLACK_ITEMS);
+	zassert_equal(stats.expired, SLACK_ITEMS);
+	zassert_equal(stats.coalesced, SLACK_ITEMS - 1);
+
+	/* Without slack the delays end on the requested ticks, and those
+	 * sharing one are not to the credit of slack.
+	 */
+	k_work_delayable_stats_reset();
+	k_sleep(K_TICKS(1));
+	now = k_uptime_ticks();
+
+	for (int i = 0; i < SLACK_ITEMS; i++) {
+		k_work_init_delayable(&slack_dwork[i], slack_handler);
+		rc = k_work_schedule_for_queue(&coophi_queue, &slack_dwork[i],
+					       K_TICKS(2 * (i / 2) + 2));
+		zassert_equal(rc, 1);
+	}
+
+	for (int i = 0; i < SLACK_ITEMS; i++) {
+		rc = k_sem_take(&slack_sem, K_FOREVER);
+		zassert_equal(rc, 0);
+	}
+
+	k_work_delayable_stats_get(&stats);
+	zassert_equal(stats.slacked, 0);
+	zassert_equal(stats.expired, SLACK_ITEMS);
+	zassert_equal(stats.coalesced, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
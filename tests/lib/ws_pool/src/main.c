@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/ws_pool.h>
+
+#define NUM_WORKERS 4
+#define NUM_INDEXES 1000
+#define NUM_JOBS (NUM_WORKERS * CONFIG_WS_POOL_DEQUE_SIZE + 8)
+
+/* Lower priority than the test thread, so workers only run once it blocks */
+#define WORKER_PRIO K_PRIO_PREEMPT(5)
+
+K_WS_POOL_DEFINE(pool, NUM_WORKERS, 2048);
+
+static atomic_t hits[NUM_INDEXES];
+static atomic_t inline_runs;
+static k_tid_t test_thread;
+
+struct test_job {
+	struct k_ws_job job;
+	int index;
+};
+
+static struct test_job jobs[NUM_JOBS];
+
+static void count_range(uint32_t begin, uint32_t end, void *arg)
+{
+	zassert_equal(arg, hits, "Invalid argument");
+	zassert_true(begin < end, "Empty range");
+
+	for (uint32_t i = begin; i < end; i++) {
+		atomic_inc(&hits[i]);
+	}
+}
+
+static void check_hits(int expected)
+{
+	for (int i = 0; i < NUM_INDEXES; i++) {
+		zassert_equal(atomic_get(&hits[i]), expected,
+			      "Index %d hit %ld times", i, atomic_get(&hits[i]));
+	}
+}
+
+static void job_handler(struct k_ws_job *job)
+{
+	struct test_job *tj = CONTAINER_OF(job, struct test_job, job);
+
+	atomic_inc(&hits[tj->index]);
+
+	if (k_current_get() == test_thread) {
+		atomic_inc(&inline_runs);
+	}
+}
+
+/* Splits its part of the indexes again from within a worker */
+static void nested_handler(struct k_ws_job *job)
+{
+	struct test_job *tj = CONTAINER_OF(job, struct test_job, job);
+	uint32_t begin = tj->index * (NUM_INDEXES / 4);
+
+	k_ws_parallel_for(&pool, begin, begin + NUM_INDEXES / 4, 10,
+			  count_range, hits);
+}
+
+static atomic_t slow_done;
+static atomic_t waited_done;
+static struct test_job slow_job;
+
+static void slow_handler(struct k_ws_job *job)
+{
+	ARG_UNUSED(job);
+
+	k_msleep(50);
+	atomic_set(&slow_done, 1);
+}
+
+/* Waits for a job another worker took, with nothing left to run itself */
+static void waiting_handler(struct k_ws_job *job)
+{
+	struct k_ws_group group;
+
+	ARG_UNUSED(job);
+
+	k_ws_group_init(&group);
+	slow_job.job.handler = slow_handler;
+	k_ws_pool_submit(&pool, &group, &slow_job.job);
+
+	/* Give an idle worker the time to steal the job */
+	k_msleep(10);
+
+	k_ws_group_wait(&pool, &group);
+	atomic_set(&waited_done, atomic_get(&slow_done));
+}
+
+static void *ws_pool_setup(void)
+{
+	k_ws_pool_start(&pool, WORKER_PRIO);
+
+	return NULL;
+}
+
+static void ws_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NUM_INDEXES; i++) {
+		atomic_set(&hits[i], 0);
+	}
+
+	atomic_set(&inline_runs, 0);
+}
+
+ZTEST(ws_pool, test_parallel_for)
+{
+	static const uint32_t grains[] = { 1, 7, 64, NUM_INDEXES, 2 * NUM_INDEXES };
+
+	for (int i = 0; i < ARRAY_SIZE(grains); i++) {
+		k_ws_parallel_for(&pool, 0, NUM_INDEXES, grains[i], count_range, hits);
+		check_hits(i + 1);
+	}
+
+	/* Empty loops do not call the body */
+	k_ws_parallel_for(&pool, 10, 10, 1, count_range, NULL);
+	k_ws_parallel_for(&pool, 10, 5, 1, count_range, NULL);
+	check_hits(ARRAY_SIZE(grains));
+}
+
+ZTEST(ws_pool, test_submit_wait)
+{
+	struct k_ws_pool_stats before, after;
+	struct k_ws_group group;
+
+	test_thread = k_current_get();
+	k_ws_pool_stats_get(&pool, &before);
+	k_ws_group_init(&group);
+
+	/* The workers cannot run before we wait, so the jobs that do not fit
+	 * in their deques are run right away by the submitter.
+	 */
+	for (int i = 0; i < NUM_JOBS; i++) {
+		jobs[i].job.handler = job_handler;
+		jobs[i].index = i;
+		k_ws_pool_submit(&pool, &group, &jobs[i].job);
+	}
+
+	zassert_equal(atomic_get(&inline_runs), NUM_JOBS - NUM_WORKERS * CONFIG_WS_POOL_DEQUE_SIZE,
+		      "Unexpected number of jobs run by the submitter");
+
+	k_ws_group_wait(&pool, &group);
+
+	for (int i = 0; i < NUM_JOBS; i++) {
+		zassert_equal(atomic_get(&hits[i]), 1, "Job %d not run once", i);
+	}
+
+	k_ws_pool_stats_get(&pool, &after);
+	zassert_equal(after.executed - before.executed, NUM_WORKERS * CONFIG_WS_POOL_DEQUE_SIZE,
+		      "Unexpected number of jobs run by the workers");
+
+	/* The group can be waited for again once done */
+	k_ws_group_wait(&pool, &group);
+}
+
+ZTEST(ws_pool, test_nested)
+{
+	struct k_ws_group group;
+
+	k_ws_group_init(&group);
+
+	for (int i = 0; i < 4; i++) {
+		jobs[i].job.handler = nested_handler;
+		jobs[i].index = i;
+		k_ws_pool_submit(&pool, &group, &jobs[i].job);
+	}
+
+	k_ws_group_wait(&pool, &group);
+
+	check_hits(1);
+}
+
+ZTEST(ws_pool, test_wait_stolen)
+{
+	struct k_ws_pool_stats before, after;
+	struct k_ws_group group;
+
+	atomic_set(&slow_done, 0);
+	atomic_set(&waited_done, 0);
+	k_ws_pool_stats_get(&pool, &before);
+	k_ws_group_init(&group);
+
+	jobs[0].job.handler = waiting_handler;
+	k_ws_pool_submit(&pool, &group, &jobs[0].job);
+	k_ws_group_wait(&pool, &group);
+
+	k_ws_pool_stats_get(&pool, &after);
+	zassert_true(after.stolen > before.stolen, "The job was not stolen");
+	zassert_equal(atomic_get(&waited_done), 1,
+		      "The wait returned before the stolen job completed");
+}
+
+ZTEST(ws_pool, test_names)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_THREAD_NAME);
+
+#ifdef CONFIG_THREAD_NAME
+	char name[CONFIG_THREAD_MAX_NAME_LEN];
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		snprintk(name, sizeof(name), "ws_pool%02d", i);
+		zassert_equal(strcmp(k_thread_name_get(&pool.workers[i].thread), name), 0,
+			      "Worker %d named %s", i, k_thread_name_get(&pool.workers[i].thread));
+	}
+#endif
+}
+
+ZTEST_SUITE(ws_pool, NULL, ws_pool_setup, ws_pool_before, NULL, NULL);
@@ -71,6 +71,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(cache_pool, 10, 16, 4, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -907,4 +908,107 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 }
 
 
+static struct net_buf *held_bufs[10];
+
+static void unref_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	net_buf_unref(held_bufs[0]);
+}
+
+static K_WORK_DELAYABLE_DEFINE(unref_work, unref_work_handler);
+
+ZTEST(net_buf_tests, test_net_buf_pool_reuse)
+{
+	struct net_buf *buf;
+
+	BUILD_ASSERT(ARRAY_SIZE(held_bufs) == 10);
+
+	/* Buffers freed by one round must all be available to the next, even
+	 * when they were kept in a per-CPU cache.
+	 */
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+			held_bufs[i] = net_buf_alloc(&cache_pool, K_NO_WAIT);
+			zassert_not_null(held_bufs[i], "Failed to get buffer %d", i);
+		}
+
+		buf = net_buf_alloc(&cache_pool, K_NO_WAIT);
+		zassert_is_null(buf, "Got more buffers than the pool has");
+
+		for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+			net_buf_unref(held_bufs[i]);
+		}
+	}
+
+	/* A blocked allocation gets the next freed buffer */
+	for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+		held_bufs[i] = net_buf_alloc(&cache_pool, K_NO_WAIT);
+		zassert_not_null(held_bufs[i], "Failed to get buffer %d", i);
+	}
+
+	k_work_schedule(&unref_work, K_MSEC(10));
+
+	buf = net_buf_alloc(&cache_pool, K_MSEC(500));
+	zassert_equal(buf, held_bufs[0], "Did not get the freed buffer");
+
+	for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+		net_buf_unref(i == 0 ? buf : held_bufs[i]);
+	}
+}
+
+#if defined(CONFIG_NET_BUF_POOL_STATS)
+ZTEST(net_buf_tests, test_net_buf_pool_stats)
+{
+	struct net_buf_pool_stats stats;
+	struct net_buf *bufs[3];
+	struct net_buf *buf;
+
+	net_buf_pool_stats_reset(&cache_pool);
+
+	for (int round = 0; round < 2; round++) {
+		for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+			bufs[i] = net_buf_alloc(&cache_pool, K_NO_WAIT);
+			zassert_not_null(bufs[i], "Failed to get buffer");
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+			net_buf_unref(bufs[i]);
+		}
+	}
+
+	net_buf_pool_stats_get(&cache_pool, &stats);
+	zassert_equal(stats.allocs, 2 * ARRAY_SIZE(bufs), "Invalid allocs");
+	zassert_equal(stats.failures, 0, "Invalid failures");
+	zassert_equal(stats.min_avail, cache_pool.buf_count - ARRAY_SIZE(bufs),
+		      "Invalid min_avail");
+	zassert_true(stats.max_alloc_cycles <= stats.alloc_cycles, "");
+
+	if (IS_ENABLED(CONFIG_NET_BUF_POOL_CPU_CACHE)) {
+		/* The second round is served by the cache */
+		zassert_true(stats.cache_hits >= ARRAY_SIZE(bufs), "Invalid cache_hits %u",
+			     stats.cache_hits);
+	} else {
+		zassert_equal(stats.cache_hits, 0, "Invalid cache_hits");
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+		held_bufs[i] = net_buf_alloc(&cache_pool, K_NO_WAIT);
+		zassert_not_null(held_bufs[i], "Failed to get buffer");
+	}
+
+	buf = net_buf_alloc(&cache_pool, K_NO_WAIT);
+	zassert_is_null(buf, "Got more buffers than the pool has");
+
+	net_buf_pool_stats_get(&cache_pool, &stats);
+	zassert_equal(stats.failures, 1, "Invalid failures");
+	zassert_equal(stats.min_avail, 0, "Invalid min_avail");
+
+	for (int i = 0; i < ARRAY_SIZE(held_bufs); i++) {
+		net_buf_unref(held_bufs[i]);
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_STATS */
+
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
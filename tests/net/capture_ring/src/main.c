@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/capture.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+#define SNAPLEN CONFIG_NET_CAPTURE_RING_SNAPLEN
+#define RING_SIZE CONFIG_NET_CAPTURE_RING_SIZE
+
+#define SHB_LEN 28
+#define IDB_LEN 20
+#define EPB_HDR_LEN 28
+
+ETH_NET_DEVICE_INIT(dummy_iface_a, "dummy_a", NULL, NULL,
+		    NULL, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    NULL, NET_ETH_MTU);
+ETH_NET_DEVICE_INIT(dummy_iface_b, "dummy_b", NULL, NULL,
+		    NULL, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    NULL, NET_ETH_MTU);
+#define dummy_iface_a NET_IF_GET_NAME(dummy_iface_a, 0)[0]
+#define dummy_iface_b NET_IF_GET_NAME(dummy_iface_b, 0)[0]
+
+static uint8_t export_buf[2 * RING_SIZE];
+static size_t export_len;
+static int export_calls;
+
+static int export_cb(const void *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	zassert_true(export_len + len <= sizeof(export_buf), "Export too long");
+
+	memcpy(export_buf + export_len, data, len);
+	export_len += len;
+	export_calls++;
+
+	return 0;
+}
+
+static int export_abort_cb(const void *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(user_data);
+
+	return -ECANCELED;
+}
+
+static void count_iface(struct net_if *iface, void *user_data)
+{
+	int *count = user_data;
+
+	ARG_UNUSED(iface);
+
+	(*count)++;
+}
+
+static uint32_t get_u32(size_t offset)
+{
+	uint32_t val;
+
+	memcpy(&val, export_buf + offset, sizeof(val));
+
+	return val;
+}
+
+static uint16_t get_u16(size_t offset)
+{
+	uint16_t val;
+
+	memcpy(&val, export_buf + offset, sizeof(val));
+
+	return val;
+}
+
+static void capture_one(struct net_if *iface, size_t len, uint8_t seed)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	for (size_t i = 0; i < len; i++) {
+		uint8_t byte = (uint8_t)(seed + i);
+
+		zassert_equal(net_pkt_write_u8(pkt, byte), 0, "Cannot write pkt");
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	net_capture_pkt(iface, pkt);
+
+	net_pkt_unref(pkt);
+}
+
+/* Export the ring, check the pcapng headers and return the offset of the
+ * first packet block.
+ */
+static size_t export_and_check_headers(void)
+{
+	int n_ifaces = 0;
+	size_t offset;
+	int ret;
+
+	net_if_foreach(count_iface, &n_ifaces);
+
+	export_len = 0;
+	export_calls = 0;
+
+	ret = net_capture_ring_export(export_cb, NULL);
+	zassert_equal(ret, export_len, "Unexpected export length (%d vs %zu)",
+		      ret, export_len);
+
+	zassert_equal(get_u32(0), 0x0A0D0D0A, "Invalid SHB type");
+	zassert_equal(get_u32(4), SHB_LEN, "Invalid SHB length");
+	zassert_equal(get_u32(8), 0x1A2B3C4D, "Invalid byte order magic");
+	zassert_equal(get_u32(SHB_LEN - 4), SHB_LEN, "Invalid SHB trailer");
+
+	offset = SHB_LEN;
+
+	for (int i = 0; i < n_ifaces; i++) {
+		zassert_equal(get_u32(offset), 1, "Invalid IDB type");
+		zassert_equal(get_u32(offset + 4), IDB_LEN, "Invalid IDB length");
+		zassert_equal(get_u32(offset + 12), SNAPLEN, "Invalid snaplen");
+		zassert_equal(get_u32(offset + IDB_LEN - 4), IDB_LEN,
+			      "Invalid IDB trailer");
+		offset += IDB_LEN;
+	}
+
+	zassert_equal(get_u16(SHB_LEN + (net_if_get_by_iface(&dummy_iface_a) - 1) * IDB_LEN + 8),
+		      1, "Ethernet link type expected");
+
+	return offset;
+}
+
+/* Check the packet block at offset and return the offset of the next one */
+static size_t check_epb(size_t offset, struct net_if *iface, size_t len, uint8_t seed)
+{
+	size_t cap_len = MIN(len, SNAPLEN);
+	size_t block_len = EPB_HDR_LEN + ROUND_UP(cap_len, 4) + 4;
+
+	zassert_true(offset + block_len <= export_len, "Truncated export");
+	zassert_equal(get_u32(offset), 6, "Invalid EPB type");
+	zassert_equal(get_u32(offset + 4), block_len, "Invalid EPB length");
+	zassert_equal(get_u32(offset + 8), net_if_get_by_iface(iface) - 1,
+		      "Invalid interface id");
+	zassert_equal(get_u32(offset + 20), cap_len, "Invalid captured length");
+	zassert_equal(get_u32(offset + 24), len, "Invalid original length");
+
+	for (size_t i = 0; i < cap_len; i++) {
+		zassert_equal(export_buf[offset + EPB_HDR_LEN + i], (uint8_t)(seed + i),
+			      "Invalid data at %zu", i);
+	}
+
+	zassert_equal(get_u32(offset + block_len - 4), block_len, "Invalid EPB trailer");
+
+	return offset + block_len;
+}
+
+ZTEST(net_capture_ring, test_capture_ring_basic)
+{
+	struct net_capture_ring_stats stats;
+	size_t offset;
+
+	zassert_ok(net_capture_ring_start(NULL), "Cannot start ring");
+
+	capture_one(&dummy_iface_a, 61, 0x10);
+	capture_one(&dummy_iface_b, 300, 0x20);
+
+	zassert_ok(net_capture_ring_stop(), "Cannot stop ring");
+	zassert_equal(net_capture_ring_stop(), -EALREADY, "Ring not stopped");
+
+	/* Not recorded as the ring is stopped */
+	capture_one(&dummy_iface_a, 40, 0x30);
+
+	offset = export_and_check_headers();
+	offset = check_epb(offset, &dummy_iface_a, 61, 0x10);
+	offset = check_epb(offset, &dummy_iface_b, 300, 0x20);
+	zassert_equal(offset, export_len, "Unexpected trailing data");
+
+	zassert_ok(net_capture_ring_stats_get(&stats), "Cannot get stats");
+	zassert_equal(stats.captured, 2, "Invalid captured count");
+	zassert_equal(stats.overwritten, 0, "Invalid overwritten count");
+	zassert_equal(stats.used, (EPB_HDR_LEN + 64 + 4) + (EPB_HDR_LEN + SNAPLEN + 4),
+		      "Invalid ring usage");
+}
+
+ZTEST(net_capture_ring, test_capture_ring_overwrite)
+{
+	struct net_capture_ring_stats stats;
+	size_t block_len = EPB_HDR_LEN + ROUND_UP(SNAPLEN, 4) + 4;
+	int n_pkts = 2 * RING_SIZE / block_len;
+	int kept = RING_SIZE / block_len;
+	size_t offset;
+
+	zassert_ok(net_capture_ring_start(NULL), "Cannot start ring");
+
+	for (int i = 0; i < n_pkts; i++) {
+		capture_one(&dummy_iface_a, SNAPLEN + 10, i);
+	}
+
+	zassert_ok(net_capture_ring_stop(), "Cannot stop ring");
+
+	zassert_ok(net_capture_ring_stats_get(&stats), "Cannot get stats");
+	zassert_equal(stats.captured, n_pkts, "Invalid captured count");
+	zassert_equal(stats.overwritten, n_pkts - kept, "Invalid overwritten count");
+	zassert_equal(stats.used, kept * block_len, "Invalid ring usage");
+
+	/* Only the newest packets are left, oldest first, and the ring has
+	 * wrapped so the export is made of two chunks of packet data.
+	 */
+	offset = export_and_check_headers();
+
+	for (int i = n_pkts - kept; i < n_pkts; i++) {
+		offset = check_epb(offset, &dummy_iface_a, SNAPLEN + 10, i);
+	}
+
+	zassert_equal(offset, export_len, "Unexpected trailing data");
+
+	zassert_equal(net_capture_ring_export(export_abort_cb, NULL), -ECANCELED,
+		      "Export not aborted");
+}
+
+ZTEST(net_capture_ring, test_capture_ring_filter)
+{
+#if defined(CONFIG_NET_PKT_FILTER)
+	static NPF_IFACE_MATCH(match_iface_b, &dummy_iface_b);
+	static NPF_SIZE_MAX(small_pkt, 100);
+	static NPF_RULE(accept_small_b, NET_OK, match_iface_b, small_pkt);
+	static struct npf_rule_list filter;
+	struct net_capture_ring_stats stats;
+	size_t offset;
+
+	npf_append_rule(&filter, &accept_small_b);
+
+	zassert_ok(net_capture_ring_start(&filter), "Cannot start ring");
+
+	capture_one(&dummy_iface_a, 50, 0x40);
+	capture_one(&dummy_iface_b, 60, 0x50);
+	capture_one(&dummy_iface_b, 200, 0x60);
+
+	zassert_ok(net_capture_ring_stop(), "Cannot stop ring");
+	zassert_true(npf_remove_all_rules(&filter), "Cannot remove rules");
+
+	zassert_ok(net_capture_ring_stats_get(&stats), "Cannot get stats");
+	zassert_equal(stats.captured, 1, "Invalid captured count");
+	zassert_equal(stats.filtered, 2, "Invalid filtered count");
+
+	offset = export_and_check_headers();
+	offset = check_epb(offset, &dummy_iface_b, 60, 0x50);
+	zassert_equal(offset, export_len, "Unexpected trailing data");
+#else
+	static struct npf_rule_list filter;
+
+	zassert_equal(net_capture_ring_start(&filter), -ENOTSUP,
+		      "Filter accepted without packet filter support");
+#endif
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, NULL, NULL, NULL, NULL);
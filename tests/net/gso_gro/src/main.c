@@ -0,0 +1,637 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define NET_LOG_LEVEL CONFIG_NET_L2_ETHERNET_LOG_LEVEL
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/random/random.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include "ipv4.h"
+#include "ipv6.h"
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#define LOCAL_PORT 4242
+#define REMOTE_PORT 8080
+#define REMOTE_PORT2 8081
+#define TEST_MSS 500
+#define TEST_ISN 100000U
+#define TEST_ACK 5000U
+#define MAX_SEGMENTS 8
+
+#define TCP_FLAG_PSH 0x08
+#define TCP_FLAG_ACK 0x10
+
+#define WAIT_TIME K_MSEC(100)
+
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static const uint8_t peer_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0xff };
+
+static uint8_t test_data[2000];
+static uint8_t frame[sizeof(struct net_eth_hdr) + NET_IPV6H_LEN + NET_TCPH_LEN +
+		     sizeof(test_data)];
+
+/* Segments seen by the connection (GRO) or by the driver (GSO) */
+struct segment {
+	uint32_t seq;
+	uint16_t len;
+	uint16_t gso_size;
+	uint8_t flags;
+	bool data_ok;
+	bool chksum_ok;
+};
+
+static struct segment segments[MAX_SEGMENTS];
+static int segment_count;
+
+static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
+
+struct eth_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context_plain;
+static struct eth_context eth_context_tso;
+
+static struct net_if *iface_plain;
+static struct net_if *iface_tso;
+
+static struct net_conn_handle *conn_handle4;
+static struct net_conn_handle *conn_handle6;
+
+static uint32_t chksum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i += 2) {
+		sum += (uint32_t)data[i] << 8;
+		if (i + 1 < len) {
+			sum += data[i + 1];
+		}
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+/* Sum of the pseudo header and the TCP segment at tcp, including the
+ * checksum field, which is 0xffff when the checksum is right.
+ */
+static uint16_t tcp_chksum(const uint8_t *ip, const uint8_t *tcp, size_t len)
+{
+	uint32_t sum = IPPROTO_TCP + len;
+
+	if ((ip[0] & 0xf0) == 0x40) {
+		sum = chksum_add(sum, ((struct net_ipv4_hdr *)ip)->src,
+				 2 * sizeof(struct in_addr));
+	} else {
+		sum = chksum_add(sum, ((struct net_ipv6_hdr *)ip)->src,
+				 2 * sizeof(struct in6_addr));
+	}
+
+	return chksum_fold(chksum_add(sum, tcp, len));
+}
+
+static bool check_data(uint32_t seq, const uint8_t *data, size_t len)
+{
+	size_t offset = seq - TEST_ISN;
+
+	return offset + len <= sizeof(test_data) &&
+	       memcmp(data, test_data + offset, len) == 0;
+}
+
+/* Parse a frame held in frame[] into segments[] */
+static void record_frame(size_t frame_len, uint16_t gso_size)
+{
+	uint8_t *ip = frame + sizeof(struct net_eth_hdr);
+	struct segment *seg = &segments[segment_count];
+	struct net_tcp_hdr *tcp_hdr;
+	size_t ip_len, len;
+
+	if (segment_count >= MAX_SEGMENTS) {
+		return;
+	}
+
+	if ((ip[0] & 0xf0) == 0x40) {
+		ip_len = NET_IPV4H_LEN;
+		len = ntohs(((struct net_ipv4_hdr *)ip)->len) - ip_len;
+		seg->chksum_ok = chksum_fold(chksum_add(0, ip, ip_len)) == 0xffff;
+	} else {
+		ip_len = NET_IPV6H_LEN;
+		len = ntohs(((struct net_ipv6_hdr *)ip)->len);
+		seg->chksum_ok = true;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(ip + ip_len);
+
+	seg->seq = sys_get_be32(tcp_hdr->seq);
+	seg->flags = tcp_hdr->flags;
+	seg->len = len - NET_TCPH_LEN;
+	seg->gso_size = gso_size;
+	seg->chksum_ok = seg->chksum_ok &&
+			 sizeof(struct net_eth_hdr) + ip_len + len == frame_len &&
+			 tcp_chksum(ip, (uint8_t *)tcp_hdr, len) == 0xffff;
+	seg->data_ok = check_data(seg->seq, (uint8_t *)tcp_hdr + NET_TCPH_LEN, seg->len);
+
+	segment_count++;
+}
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+
+	ARG_UNUSED(dev);
+
+	zassert_true(len <= sizeof(frame), "Too long packet (%zu)", len);
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, frame, len), "Cannot read packet");
+
+	record_frame(len, net_pkt_gso_size(pkt));
+
+	k_sem_give(&wait_data);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps_plain(const struct device *dev)
+{
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_caps_tso(const struct device *dev)
+{
+	return ETHERNET_HW_TSO;
+}
+
+static struct ethernet_api api_funcs_plain = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_caps_plain,
+	.send = eth_tx,
+};
+
+static struct ethernet_api api_funcs_tso = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_caps_tso,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = context == &eth_context_plain ? 0x01 : 0x02;
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_plain_test, "eth_plain_test",
+		    eth_init, NULL, &eth_context_plain, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs_plain, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_tso_test, "eth_tso_test",
+		    eth_init, NULL, &eth_context_tso, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs_tso, NET_ETH_MTU);
+
+static enum net_verdict tcp_received(struct net_conn *conn, struct net_pkt *pkt,
+				     union net_ip_header *ip_hdr,
+				     union net_proto_header *proto_hdr,
+				     void *user_data)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) + NET_TCPH_LEN;
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+	struct segment *seg = &segments[segment_count];
+
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(user_data);
+
+	if (segment_count < MAX_SEGMENTS && len <= sizeof(test_data)) {
+		seg->seq = sys_get_be32(proto_hdr->tcp->seq);
+		seg->flags = proto_hdr->tcp->flags;
+		seg->len = len;
+		seg->chksum_ok = true;
+
+		net_pkt_cursor_init(pkt);
+		seg->data_ok = net_pkt_skip(pkt, hdr_len) == 0 &&
+			       net_pkt_read(pkt, frame, len) == 0 &&
+			       check_data(seg->seq, frame, len);
+
+		segment_count++;
+	}
+
+	net_pkt_unref(pkt);
+
+	k_sem_give(&wait_data);
+
+	return NET_OK;
+}
+
+/* Build the frame a peer sends to iface_plain, carrying len bytes of the
+ * test data from offset on.
+ */
+static struct net_pkt *peer_segment(sa_family_t family, uint16_t src_port,
+				    size_t offset, size_t len, uint8_t flags)
+{
+	struct net_eth_hdr *eth_hdr = (struct net_eth_hdr *)frame;
+	uint8_t *ip = frame + sizeof(struct net_eth_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *pkt;
+	size_t ip_len;
+
+	memset(frame, 0, sizeof(frame));
+
+	memcpy(eth_hdr->dst.addr, eth_context_plain.mac_addr, sizeof(eth_hdr->dst.addr));
+	memcpy(eth_hdr->src.addr, peer_mac, sizeof(eth_hdr->src.addr));
+
+	if (family == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)ip;
+
+		eth_hdr->type = htons(NET_ETH_PTYPE_IP);
+		ip_len = NET_IPV4H_LEN;
+
+		ipv4_hdr->vhl = 0x45;
+		ipv4_hdr->len = htons(ip_len + NET_TCPH_LEN + len);
+		sys_put_be16(NET_IPV4_DF << 13, ipv4_hdr->offset);
+		ipv4_hdr->ttl = 64;
+		ipv4_hdr->proto = IPPROTO_TCP;
+		memcpy(ipv4_hdr->src, &peer_addr4, sizeof(struct in_addr));
+		memcpy(ipv4_hdr->dst, &my_addr4, sizeof(struct in_addr));
+		ipv4_hdr->chksum = htons(~chksum_fold(chksum_add(0, ip, ip_len)));
+	} else {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)ip;
+
+		eth_hdr->type = htons(NET_ETH_PTYPE_IPV6);
+		ip_len = NET_IPV6H_LEN;
+
+		ipv6_hdr->vtc = 0x60;
+		ipv6_hdr->len = htons(NET_TCPH_LEN + len);
+		ipv6_hdr->nexthdr = IPPROTO_TCP;
+		ipv6_hdr->hop_limit = 64;
+		memcpy(ipv6_hdr->src, &peer_addr6, sizeof(struct in6_addr));
+		memcpy(ipv6_hdr->dst, &my_addr6, sizeof(struct in6_addr));
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(ip + ip_len);
+	tcp_hdr->src_port = htons(src_port);
+	tcp_hdr->dst_port = htons(LOCAL_PORT);
+	sys_put_be32(TEST_ISN + offset, tcp_hdr->seq);
+	sys_put_be32(TEST_ACK, tcp_hdr->ack);
+	tcp_hdr->offset = (NET_TCPH_LEN / 4) << 4;
+	tcp_hdr->flags = flags;
+	sys_put_be16(8192, tcp_hdr->wnd);
+
+	memcpy((uint8_t *)tcp_hdr + NET_TCPH_LEN, test_data + offset, len);
+
+	tcp_hdr->chksum = htons(~tcp_chksum(ip, (uint8_t *)tcp_hdr, NET_TCPH_LEN + len));
+
+	len += sizeof(struct net_eth_hdr) + ip_len + NET_TCPH_LEN;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface_plain, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_ok(net_pkt_write(pkt, frame, len), "Cannot write packet");
+
+	return pkt;
+}
+
+static void peer_send(struct net_pkt *pkt)
+{
+	zassert_ok(net_recv_data(iface_plain, pkt), "Cannot receive packet");
+}
+
+/* Wait until the stack has processed everything queued so far */
+static int wait_segments(int count)
+{
+	while (k_sem_take(&wait_data, WAIT_TIME) == 0) {
+	}
+
+	zassert_equal(segment_count, count, "Got %d segments, expected %d",
+		      segment_count, count);
+
+	return segment_count;
+}
+
+static void check_segment(int i, size_t offset, size_t len, bool psh)
+{
+	zassert_equal(segments[i].seq, TEST_ISN + offset, "Segment %d, wrong seq", i);
+	zassert_equal(segments[i].len, len, "Segment %d, wrong length %u", i,
+		      segments[i].len);
+	zassert_equal(!!(segments[i].flags & TCP_FLAG_PSH), psh,
+		      "Segment %d, wrong PSH flag", i);
+	zassert_true(segments[i].chksum_ok, "Segment %d, wrong checksum", i);
+	zassert_true(segments[i].data_ok, "Segment %d, wrong data", i);
+}
+
+ZTEST(net_gso_gro, test_gro_ipv4)
+{
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 0, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 500, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1000, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1500, 300,
+			       TCP_FLAG_ACK | TCP_FLAG_PSH));
+	k_sched_unlock();
+
+	wait_segments(1);
+	check_segment(0, 0, 1800, true);
+}
+
+ZTEST(net_gso_gro, test_gro_ipv6)
+{
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET6, REMOTE_PORT, 0, 400, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET6, REMOTE_PORT, 400, 400, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET6, REMOTE_PORT, 800, 401, TCP_FLAG_ACK));
+	k_sched_unlock();
+
+	/* A segment longer than the first one is not coalesced */
+	wait_segments(2);
+	check_segment(0, 0, 800, false);
+	check_segment(1, 800, 401, false);
+}
+
+ZTEST(net_gso_gro, test_gro_out_of_order)
+{
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 0, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1000, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 500, 500, TCP_FLAG_ACK));
+	k_sched_unlock();
+
+	wait_segments(3);
+	check_segment(0, 0, 500, false);
+	check_segment(1, 1000, 500, false);
+	check_segment(2, 500, 500, false);
+}
+
+ZTEST(net_gso_gro, test_gro_push)
+{
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 0, 500,
+			       TCP_FLAG_ACK | TCP_FLAG_PSH));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 500, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1000, 500,
+			       TCP_FLAG_ACK | TCP_FLAG_PSH));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1500, 500, TCP_FLAG_ACK));
+	k_sched_unlock();
+
+	wait_segments(3);
+	check_segment(0, 0, 500, true);
+	check_segment(1, 500, 1000, true);
+	check_segment(2, 1500, 500, false);
+}
+
+ZTEST(net_gso_gro, test_gro_interleaved)
+{
+	/* Steering may put the two flows to different RX queues, where
+	 * each one is coalesced on its own.
+	 */
+	if (IS_ENABLED(CONFIG_NET_RPS)) {
+		ztest_test_skip();
+	}
+
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 0, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT2, 500, 500, TCP_FLAG_ACK));
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 500, 500, TCP_FLAG_ACK));
+	k_sched_unlock();
+
+	wait_segments(3);
+	check_segment(0, 0, 500, false);
+	check_segment(1, 500, 500, false);
+	check_segment(2, 500, 500, false);
+}
+
+ZTEST(net_gso_gro, test_gro_corrupted)
+{
+	struct net_pkt *pkt;
+
+	k_sched_lock();
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 0, 500, TCP_FLAG_ACK));
+
+	/* Flip a payload bit after the checksum is calculated */
+	pkt = peer_segment(AF_INET, REMOTE_PORT, 500, 500, TCP_FLAG_ACK);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	frame[sizeof(struct net_eth_hdr) + NET_IPV4H_LEN + NET_TCPH_LEN + 10] ^= 0x01;
+	net_pkt_write(pkt, frame, net_pkt_get_len(pkt));
+	net_pkt_set_overwrite(pkt, false);
+	peer_send(pkt);
+
+	peer_send(peer_segment(AF_INET, REMOTE_PORT, 1000, 500, TCP_FLAG_ACK));
+	k_sched_unlock();
+
+	/* The coalesced packet fails the checksum check as a whole */
+	wait_segments(0);
+}
+
+/* Build a TCP packet of the size of several segments, as TCP does */
+static struct net_pkt *gso_packet(struct net_if *iface, sa_family_t family,
+				  size_t len)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	net_pkt_set_family(pkt, family);
+
+	ret = net_pkt_alloc_buffer_raw(pkt, NET_IPV6H_LEN + NET_TCPH_LEN + len, K_NO_WAIT);
+	zassert_ok(ret, "Cannot allocate buffer");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &my_addr4, &peer_addr4);
+	} else {
+		ret = net_ipv6_create(pkt, &my_addr6, &peer_addr6);
+	}
+
+	zassert_ok(ret, "Cannot create IP header");
+
+	tcp_hdr.src_port = htons(LOCAL_PORT);
+	tcp_hdr.dst_port = htons(REMOTE_PORT);
+	sys_put_be32(TEST_ISN, tcp_hdr.seq);
+	sys_put_be32(TEST_ACK, tcp_hdr.ack);
+	tcp_hdr.offset = (NET_TCPH_LEN / 4) << 4;
+	tcp_hdr.flags = TCP_FLAG_ACK | TCP_FLAG_PSH;
+	sys_put_be16(8192, tcp_hdr.wnd);
+
+	zassert_ok(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), "Cannot write");
+	zassert_ok(net_pkt_write(pkt, test_data, len), "Cannot write");
+
+	net_pkt_set_gso_size(pkt, TEST_MSS);
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_ok(ret, "Cannot finalize packet");
+
+	return pkt;
+}
+
+static void test_gso_split(sa_family_t family)
+{
+	struct net_pkt *pkt = gso_packet(iface_plain, family, 3 * TEST_MSS + 250);
+
+	zassert_ok(net_send_data(pkt), "Cannot send packet");
+
+	wait_segments(4);
+	check_segment(0, 0, TEST_MSS, false);
+	check_segment(1, TEST_MSS, TEST_MSS, false);
+	check_segment(2, 2 * TEST_MSS, TEST_MSS, false);
+	check_segment(3, 3 * TEST_MSS, 250, true);
+
+	for (int i = 0; i < segment_count; i++) {
+		zassert_equal(segments[i].gso_size, 0, "Segment %d is a GSO packet", i);
+	}
+}
+
+ZTEST(net_gso_gro, test_gso_ipv4)
+{
+	test_gso_split(AF_INET);
+}
+
+ZTEST(net_gso_gro, test_gso_ipv6)
+{
+	test_gso_split(AF_INET6);
+}
+
+ZTEST(net_gso_gro, test_gso_tso)
+{
+	struct net_pkt *pkt = gso_packet(iface_tso, AF_INET, 3 * TEST_MSS + 250);
+
+	zassert_ok(net_send_data(pkt), "Cannot send packet");
+
+	/* The hardware segments the packet */
+	wait_segments(1);
+	zassert_equal(segments[0].len, 3 * TEST_MSS + 250, "Packet was segmented");
+	zassert_equal(segments[0].gso_size, TEST_MSS, "Segment size is lost");
+	zassert_true(segments[0].data_ok, "Wrong data");
+}
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return;
+	}
+
+	if (net_if_get_device(iface)->data == &eth_context_plain) {
+		iface_plain = iface;
+	} else if (net_if_get_device(iface)->data == &eth_context_tso) {
+		iface_tso = iface;
+	}
+}
+
+static void *net_gso_gro_setup(void)
+{
+	struct sockaddr_in local4 = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr4,
+	};
+	struct sockaddr_in6 local6 = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = my_addr6,
+	};
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	int ret;
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+
+	net_if_foreach(iface_cb, NULL);
+
+	zassert_not_null(iface_plain, "No interface without TSO");
+	zassert_not_null(iface_tso, "No interface with TSO");
+
+	zassert_not_null(net_if_ipv4_addr_add(iface_plain, &my_addr4, NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv4 address");
+	net_if_ipv4_set_netmask_by_addr(iface_plain, &my_addr4, &netmask);
+	zassert_not_null(net_if_ipv6_addr_add(iface_plain, &my_addr6, NET_ADDR_MANUAL, 0),
+			 "Cannot add IPv6 address");
+
+	/* The peer is not in the neighbor cache */
+	net_if_flag_set(iface_plain, NET_IF_IPV6_NO_ND);
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET, NULL, (struct sockaddr *)&local4,
+				0, LOCAL_PORT, NULL, tcp_received, NULL, &conn_handle4);
+	zassert_ok(ret, "Cannot register IPv4 connection");
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET6, NULL, (struct sockaddr *)&local6,
+				0, LOCAL_PORT, NULL, tcp_received, NULL, &conn_handle6);
+	zassert_ok(ret, "Cannot register IPv6 connection");
+
+	return NULL;
+}
+
+static void net_gso_gro_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&wait_data);
+	memset(segments, 0, sizeof(segments));
+	segment_count = 0;
+}
+
+ZTEST_SUITE(net_gso_gro, NULL, net_gso_gro_setup, net_gso_gro_before, NULL, NULL);
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait which times out takes +10ms from the requested time. */
+#define FUZZ 10
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
+
+static int wakeup_sock = -1;
+
+static void send_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)send(wakeup_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+}
+
+static K_WORK_DELAYABLE_DEFINE(send_work, send_work_handler);
+
+static void epoll_add(int epfd, int fd, uint32_t events, uint32_t data)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+	int res;
+
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+}
+
+static void prepare_udp_pair(int *c_sock, int *s_sock, uint16_t s_port)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, s_port, s_sock, &s_addr);
+
+	res = bind(*s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = connect(*c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+}
+
+ZTEST_USER(net_socket_epoll, test_epoll_udp)
+{
+	struct epoll_event events[2];
+	struct epoll_event ev = { .events = EPOLLIN };
+	int c_sock, s_sock, other_sock;
+	struct sockaddr_in6 addr;
+	uint32_t tstamp;
+	ssize_t len;
+	char buf[10];
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock, SERVER_PORT);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &other_sock, &addr);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN, 1);
+	epoll_add(epfd, c_sock, EPOLLIN, 2);
+
+	/* Invalid operations */
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, other_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(s_sock, EPOLL_CTL_ADD, other_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = epoll_wait(epfd, events, 0, 0);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	/* Socket calls on an epoll instance are not supported */
+	res = bind(epfd, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EOPNOTSUPP, "");
+
+	/* Wait on non-ready sockets with timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Wait on non-ready sockets with timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	/* Send pkt for s_sock */
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	/* Level-triggered, reported until the data is read */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* UDP sockets are always writable */
+	ev.events = EPOLLIN | EPOLLOUT;
+	ev.data.u32 = 3;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, c_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.u32, 3, "");
+
+	/* Removed sockets are not reported anymore */
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, 0, "");
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 0, "");
+
+	/* Closing a socket removes it from the interest list */
+	epoll_add(epfd, s_sock, EPOLLIN, 1);
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(other_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_epoll, test_epoll_oneshot)
+{
+	struct epoll_event events[1];
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLONESHOT,
+		.data.u32 = 1,
+	};
+	int c_sock, s_sock;
+	ssize_t len;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock, SERVER_PORT);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN | EPOLLONESHOT, 1);
+
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	/* Disabled until rearmed, even though data is still pending */
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 0, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+ZTEST_USER(net_socket_epoll, test_epoll_fairness)
+{
+	struct epoll_event events[1];
+	int c_sock[3], s_sock[3];
+	uint32_t seen = 0U;
+	ssize_t len;
+	int epfd;
+	int res;
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		prepare_udp_pair(&c_sock[i], &s_sock[i], SERVER_PORT + i);
+		epoll_add(epfd, s_sock[i], EPOLLIN, BIT(i));
+
+		len = send(c_sock[i], BUF_AND_SIZE(TEST_STR_SMALL), 0);
+		zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+	}
+
+	k_msleep(10);
+
+	/* Ready sockets take turns when they do not fit in one wait */
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+		zassert_equal(res, 1, "");
+		seen |= events[0].data.u32;
+	}
+
+	zassert_equal(seen, BIT_MASK(ARRAY_SIZE(s_sock)), "seen 0x%x", seen);
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		res = close(c_sock[i]);
+		zassert_equal(res, 0, "close failed");
+		res = close(s_sock[i]);
+		zassert_equal(res, 0, "close failed");
+	}
+}
+
+/* Runs in supervisor mode to submit the work item */
+ZTEST(net_socket_epoll, test_epoll_wakeup)
+{
+	struct epoll_event events[1];
+	int c_sock, s_sock;
+	uint32_t tstamp;
+	int epfd;
+	int res;
+
+	prepare_udp_pair(&c_sock, &s_sock, SERVER_PORT);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN, 1);
+
+	/* A blocked wait returns as soon as the data arrives */
+	wakeup_sock = c_sock;
+	k_work_schedule(&send_work, K_MSEC(50));
+
+	tstamp = k_uptime_get_32();
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_true(tstamp >= 50U && tstamp <= 50 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
+#define TEST_SNDBUF_SIZE CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE
+
+ZTEST_USER(net_socket_epoll, test_epoll_tcp)
+{
+	struct epoll_event events[2];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	char buf[TEST_SNDBUF_SIZE] = { };
+	int c_sock, s_sock, new_sock;
+	int epfd;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = listen(s_sock, 0);
+	zassert_equal(res, 0, "");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	epoll_add(epfd, s_sock, EPOLLIN, 1);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* A pending connection makes the listening socket readable */
+	res = connect(c_sock, (const struct sockaddr *)&s_addr,
+		      sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 1, "");
+
+	new_sock = accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	k_msleep(10);
+
+	/* EPOLLOUT is reported while there is room in the window */
+	epoll_add(epfd, c_sock, EPOLLOUT, 2);
+	epoll_add(epfd, new_sock, EPOLLIN, 3);
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.u32, 2, "");
+
+	res = send(c_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+	zassert_equal(events[0].data.u32, 3, "");
+
+	/* Consuming the data server side opens the window again. Wait
+	 * longer this time to give TCP stack a chance to send ZWP.
+	 */
+	res = recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 500);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+	zassert_equal(events[0].data.u32, 2, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	/* Peer close is reported as readable and hung up */
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, EPOLLIN | EPOLLHUP, "");
+	zassert_equal(events[0].data.u32, 3, "");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+	res = close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -358,7 +358,8 @@ void tcp_server_block_thread(void *vps_sock, void *unused2, void *unused3)
 	test_close(new_sock);
 }
 
-void test_send_recv_large_common(int tcp_nodelay, int family)
+void test_send_recv_large_common(int tcp_nodelay, int family, const char *congestion,
+				 struct tcp_info *info)
 {
 	int rv;
 	int c_sock;
@@ -388,6 +389,12 @@ void test_send_recv_large_common(int tcp_nodelay, int family)
 		zassert_unreachable();
 	}
 
+	if (congestion != NULL) {
+		rv = setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, congestion,
+				strlen(congestion));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
 	test_bind(s_sock, s_saddr, addrlen);
 	test_listen(s_sock);
 
@@ -435,6 +442,14 @@ void test_send_recv_large_common(int tcp_nodelay, int family)
 	zassert_equal(k_thread_join(&tcp_server_thread_data, K_SECONDS(60)), 0,
 			"Not successfully wait for TCP thread to finish");
 
+	if (info != NULL) {
+		socklen_t optlen = sizeof(*info);
+
+		rv = getsockopt(c_sock, IPPROTO_TCP, TCP_INFO, info, &optlen);
+		zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(optlen, sizeof(*info), "getsockopt got invalid size");
+	}
+
 	test_close(s_sock);
 	test_close(c_sock);
 
@@ -458,39 +473,54 @@ static void restore_packet_loss_ratio(void)
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, AF_INET, NULL, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET);
+	test_send_recv_large_common(0, AF_INET, NULL, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET);
+	test_send_recv_large_common(1, AF_INET, NULL, NULL);
 	restore_packet_loss_ratio();
 }
 
+ZTEST(net_socket_tcp, test_v4_send_recv_large_cubic)
+{
+	struct tcp_info info;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_CUBIC);
+
+	set_packet_loss_ratio();
+	test_send_recv_large_common(0, AF_INET, "cubic", &info);
+	restore_packet_loss_ratio();
+
+	zassert_true(info.tcpi_snd_mss > 0, "no mss reported");
+	zassert_true(info.tcpi_snd_cwnd > 0, "no congestion window reported");
+	zassert_true(info.tcpi_total_retrans > 0, "lost segments not counted");
+}
+
 ZTEST(net_socket_tcp, test_v6_send_recv_large_normal)
 {
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, AF_INET6, NULL, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(0, AF_INET6);
+	test_send_recv_large_common(0, AF_INET6, NULL, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v6_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_send_recv_large_common(1, AF_INET6);
+	test_send_recv_large_common(1, AF_INET6, NULL, NULL);
 	restore_packet_loss_ratio();
 }
 
@@ -2491,6 +2521,52 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, CONFIG_NET_TCP_CONGESTION_DEFAULT), 0, "wrong default algorithm");
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "none", strlen("none"));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, ENOENT, "wrong errno value, %d", errno);
+
+	/* The name does not need to be terminated */
+	ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno", strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, "reno"), 0, "algorithm not changed");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic", sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(name, "cubic"), 0, "algorithm not changed");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -9,6 +9,7 @@
 LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <stdio.h>
+#include <time.h>
 #include <zephyr/sys/mutex.h>
 #include <zephyr/ztest_assert.h>
 
@@ -2408,6 +2409,208 @@ ZTEST_USER(net_socket_udp, test_35_recvmsg_msg_controllen_update)
 	zassert_equal(rv, 0, "close failed");
 }
 
+ZTEST_USER(net_socket_udp, test_36_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[] = { TEST_STR_SMALL, TEST_STR2, "!" };
+	char bufs[ARRAY_SIZE(payloads)][STRLEN(TEST_STR2) + 1];
+	struct mmsghdr msgs[ARRAY_SIZE(payloads)];
+	struct iovec iov[ARRAY_SIZE(payloads)];
+	struct sockaddr_in addrs[ARRAY_SIZE(payloads)];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct timespec timeout = { 0 };
+	int client_sock;
+	int server_sock;
+	int ret;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr)),
+		   "bind failed");
+	zassert_ok(bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr)),
+		   "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		iov[i].iov_base = (void *)payloads[i];
+		iov[i].iov_len = strlen(payloads[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* The destination of the connected socket is used */
+	zassert_ok(connect(client_sock, (struct sockaddr *)&server_addr, sizeof(server_addr)),
+		   "connect failed");
+
+	ret = sendmmsg(client_sock, msgs, ARRAY_SIZE(msgs), 0);
+	zassert_equal(ret, ARRAY_SIZE(msgs), "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]), "wrong length sent");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+	memset(bufs, 0, sizeof(bufs));
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+
+	/* Without MSG_WAITFORONE, the call waits for all the datagrams */
+	ret = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), 0, NULL);
+	zassert_equal(ret, ARRAY_SIZE(msgs), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]), "wrong length received");
+		zassert_mem_equal(bufs[i], payloads[i], strlen(payloads[i]), "wrong data");
+		zassert_equal(addrs[i].sin_port, client_addr.sin_port, "wrong source");
+	}
+
+	ret = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), MSG_DONTWAIT, NULL);
+	zassert_equal(ret, -1, "recvmmsg succeeded");
+	zassert_equal(errno, EAGAIN, "wrong errno (%d)", errno);
+
+	ret = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), 0, &timeout);
+	zassert_equal(ret, -1, "recvmmsg succeeded");
+	zassert_equal(errno, ENOTSUP, "wrong errno (%d)", errno);
+
+	/* Only the first datagram is waited for with MSG_WAITFORONE */
+	ret = send(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(ret, STRLEN(TEST_STR_SMALL), "send failed (%d)", errno);
+
+	iov[0].iov_len = sizeof(bufs[0]);
+	ret = recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs), MSG_WAITFORONE, NULL);
+	zassert_equal(ret, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(msgs[0].msg_len, STRLEN(TEST_STR_SMALL), "wrong length received");
+
+	zassert_ok(close(client_sock), "close failed");
+	zassert_ok(close(server_sock), "close failed");
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY)
+static int zc_released;
+
+static void zc_destroy(struct net_buf *buf)
+{
+	zc_released++;
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_DEFINE(zc_pool, 4, 16, 0, zc_destroy);
+
+static void test_zero_copy(int sock_c, int sock_s, struct sockaddr *addr_s,
+			   socklen_t addrlen_s)
+{
+	static const char payload[] = TEST_STR2;
+	size_t total = STRLEN(TEST_STR_SMALL) + STRLEN(TEST_STR2);
+	struct net_buf *hdr, *buf;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	ssize_t len;
+
+	zc_released = 0;
+
+	/* Small header followed by data which is not owned by the pool */
+	hdr = net_buf_alloc(&zc_pool, K_NO_WAIT);
+	zassert_not_null(hdr, "cannot allocate header");
+	net_buf_add_mem(hdr, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	buf = net_buf_alloc_with_data(&zc_pool, (void *)payload, STRLEN(TEST_STR2),
+				      K_NO_WAIT);
+	zassert_not_null(buf, "cannot allocate payload");
+	net_buf_frag_add(hdr, buf);
+
+	len = zsock_send_buf(sock_c, hdr, 0, addr_s, addrlen_s);
+	zassert_equal(len, total, "send_buf failed (%d)", errno);
+	net_buf_unref(hdr);
+
+	len = zsock_recv_buf(sock_s, &buf, 0, &addr, &addrlen);
+	zassert_equal(len, total, "recv_buf failed (%d)", errno);
+	zassert_not_null(buf, "no buffer received");
+	zassert_equal(net_buf_frags_len(buf), total, "buffer holds more than payload");
+	zassert_equal(addr.sa_family, addr_s->sa_family, "unexpected family");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), buf, 0, total);
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "wrong data");
+	zassert_mem_equal(rx_buf + STRLEN(TEST_STR_SMALL), TEST_STR2, STRLEN(TEST_STR2),
+			  "wrong data");
+	net_buf_unref(buf);
+
+	/* The stack must not hold the sent buffers anymore */
+	zassert_equal(zc_released, 2, "sent buffers not released");
+
+	zassert_equal(zsock_recv_buf(sock_s, &buf, ZSOCK_MSG_DONTWAIT, NULL, NULL), -1);
+	zassert_equal(errno, EAGAIN, "expected EAGAIN");
+	zassert_is_null(buf, "no buffer expected");
+
+	zassert_equal(zsock_recv_buf(sock_s, &buf, ZSOCK_MSG_PEEK, NULL, NULL), -1);
+	zassert_equal(errno, EOPNOTSUPP, "peek is not supported");
+
+	buf = (struct net_buf *)&zc_pool;
+	zassert_equal(zsock_recv_buf(-1, &buf, 0, NULL, NULL), -1);
+	zassert_equal(errno, EBADF, "expected EBADF");
+	zassert_is_null(buf, "no buffer expected");
+
+	/* Connected socket, datagrams received by copy still work */
+	zassert_ok(connect(sock_c, addr_s, addrlen_s), "connect failed");
+	hdr = net_buf_alloc(&zc_pool, K_NO_WAIT);
+	net_buf_add_mem(hdr, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	len = zsock_send_buf(sock_c, hdr, 0, NULL, 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "send_buf failed (%d)", errno);
+	net_buf_unref(hdr);
+
+	clear_buf(rx_buf);
+	len = recv(sock_s, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "recv failed");
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR_SMALL), "wrong data");
+}
+
+ZTEST(net_socket_udp, test_16_v4_zero_copy)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr)),
+		   "bind failed");
+
+	test_zero_copy(client_sock, server_sock, (struct sockaddr *)&server_addr,
+		       sizeof(server_addr));
+
+	zassert_ok(close(client_sock), "close failed");
+	zassert_ok(close(server_sock), "close failed");
+}
+
+ZTEST(net_socket_udp, test_16_v6_zero_copy)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	zassert_ok(bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr)),
+		   "bind failed");
+
+	test_zero_copy(client_sock, server_sock, (struct sockaddr *)&server_addr,
+		       sizeof(server_addr));
+
+	zassert_ok(close(client_sock), "close failed");
+	zassert_ok(close(server_sock), "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY */
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
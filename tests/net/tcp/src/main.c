@@ -136,6 +136,8 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt);
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
+static void handle_server_sack(struct net_pkt *pkt);
+static void handle_client_sack(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -233,6 +235,11 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options and window of the segments sent by the peer */
+static const uint8_t *peer_options;
+static size_t peer_options_len;
+static uint16_t peer_window = NET_IPV6_MTU;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -243,10 +250,12 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
+	const uint8_t *opts = peer_options;
+	uint8_t opts_len = peer_options_len;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -282,14 +291,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = peer_window;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -301,9 +305,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -485,6 +489,13 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 17:
 		handle_client_fin_wait_2_failure_test(net_pkt_family(pkt), &th);
 		break;
+	case 18:
+		handle_server_sack(pkt);
+		break;
+	case 19:
+	case 20:
+		handle_client_sack(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -2005,7 +2016,7 @@ ZTEST(net_tcp, test_client_invalid_rst)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -2408,4 +2419,507 @@ ZTEST(net_tcp, test_client_rst_on_unexpected_ack_on_syn)
 	test_sem_take(K_MSEC(100), __LINE__);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+#define SACK_SEQ_INIT 1000
+#define SACK_OPT_LEN  (2 + NET_TCP_SACK_BLOCK_SIZE)
+
+/* Look for a TCP option in a segment sent by the stack, the option is
+ * copied to buf and its length is returned.
+ */
+static int get_tcp_option(struct net_pkt *pkt, uint8_t kind, uint8_t *buf,
+			  size_t buf_len)
+{
+	uint8_t opts[40];
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len = (th.th_off - 5U) * 4U;
+
+	net_pkt_set_overwrite(pkt, true);
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret == 0) {
+		ret = net_pkt_read(pkt, opts, len);
+	}
+
+	net_pkt_cursor_init(pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (size_t i = 0; i + 1 < len && opts[i] != NET_TCP_END_OPT; ) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (opts[i + 1] < 2U) {
+			break;
+		}
+
+		if (opts[i] == kind) {
+			memcpy(buf, &opts[i], MIN(opts[i + 1], buf_len));
+			return opts[i + 1];
+		}
+
+		i += opts[i + 1];
+	}
+
+	return -ENOENT;
+}
+
+static uint8_t sack_syn_options[12] = {
+	0x02, 0x04, 0x05, 0xb4, /* Max segment */
+	0x01, 0x01, 0x04, 0x02, /* SACK permitted */
+	0x01, 0x03, 0x03, 0x07, /* Win scale */
+};
+
+static uint32_t sack_ack;
+static uint16_t sack_win;
+static int sack_len;
+static struct tcp_sack_block sack_blk;
+
+static void handle_server_sack(struct net_pkt *pkt)
+{
+	uint8_t opt[SACK_OPT_LEN];
+	struct tcphdr th;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	test_verify_flags(&th, ACK);
+
+	sack_ack = ntohl(th.th_ack);
+	sack_win = ntohs(th.th_win);
+	sack_len = get_tcp_option(pkt, NET_TCP_SACK_OPT, opt, sizeof(opt));
+	if (sack_len == SACK_OPT_LEN) {
+		sack_blk.left = ntohl(UNALIGNED_GET((uint32_t *)&opt[2]));
+		sack_blk.right = ntohl(UNALIGNED_GET((uint32_t *)&opt[6]));
+	}
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
+}
+
+static void send_server_sack_data(uint32_t seq_offset, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = SACK_SEQ_INIT + 1 + seq_offset;
+	pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				  lorem_ipsum + seq_offset, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Peer will release the semaphore after it gets the ACK */
+	test_sem_take(K_MSEC(100), __LINE__);
+}
+
+/* Test case scenario IPv6
+ *   the peer offers SACK and window scaling in its SYN,
+ *   send out-of-order data,
+ *   expect a duplicate ACK reporting the data in a SACK block,
+ *   send the missing data,
+ *   expect an ACK for all the data and no SACK block.
+ */
+ZTEST(net_tcp, test_server_sack)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	struct net_pkt *rst;
+	int ret;
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	peer_options = sack_syn_options;
+	peer_options_len = sizeof(sack_syn_options);
+	ctx = create_server_socket(SACK_SEQ_INIT, 0);
+	peer_options = NULL;
+	peer_options_len = 0;
+
+	conn = accepted_ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	zassert_true(conn->wscale_ok, "Window scaling not negotiated");
+	zassert_equal(conn->send_wscale, 7, "Invalid send window shift");
+	zassert_true((conn->recv_win_max >> conn->recv_wscale) <= UINT16_MAX,
+		     "Invalid receive window shift");
+#endif
+
+	test_case_no = 18;
+
+	send_server_sack_data(10, 10);
+	zassert_equal(sack_ack, SACK_SEQ_INIT + 1, "Invalid ACK %u", sack_ack);
+	zassert_equal(sack_len, SACK_OPT_LEN, "Missing SACK block");
+	zassert_equal(sack_blk.left, SACK_SEQ_INIT + 1 + 10, "Invalid SACK block");
+	zassert_equal(sack_blk.right, SACK_SEQ_INIT + 1 + 20, "Invalid SACK block");
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	zassert_equal(sack_win, MIN(conn->recv_win >> conn->recv_wscale, UINT16_MAX),
+		      "Window not scaled");
+#endif
+
+	send_server_sack_data(0, 10);
+	zassert_equal(sack_ack, SACK_SEQ_INIT + 1 + 20, "Invalid ACK %u", sack_ack);
+	zassert_equal(sack_len, -ENOENT, "Unexpected SACK block");
+
+	/* Abort the connection */
+	seq = sack_ack;
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define SACK_MSS      80 /* Below the MSS of the dummy interface */
+#define SACK_SEGMENTS 5
+
+static uint8_t sack_syn_ack_options[8] = {
+	0x02, 0x04, 0x00, SACK_MSS, /* Max segment */
+	0x01, 0x01, 0x04, 0x02, /* SACK permitted */
+};
+
+/* Segments lost on their first transmission */
+static const bool sack_lost[SACK_SEGMENTS] = { true, false, true, false, false };
+static int sack_sent[SACK_SEGMENTS];
+static uint32_t sack_data_seq;
+static uint16_t sack_port;
+
+/* Report a block of data that has not been sent yet, once the congestion
+ * window is full, instead of acking the segments received.
+ */
+static bool sack_unsent;
+#define SACK_WINDOW_SEGMENTS 2
+
+static void send_client_sack_unsent(sa_family_t af, uint16_t dst_port)
+{
+	uint8_t opts[4 + 2 * NET_TCP_SACK_BLOCK_SIZE] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_OPT,
+		2 + 2 * NET_TCP_SACK_BLOCK_SIZE,
+	};
+	struct net_pkt *reply;
+
+	/* The second segment, which was sent, and the fourth, which was not */
+	UNALIGNED_PUT(htonl(sack_data_seq + SACK_MSS), (uint32_t *)&opts[4]);
+	UNALIGNED_PUT(htonl(sack_data_seq + 2 * SACK_MSS), (uint32_t *)&opts[8]);
+	UNALIGNED_PUT(htonl(sack_data_seq + 3 * SACK_MSS), (uint32_t *)&opts[12]);
+	UNALIGNED_PUT(htonl(sack_data_seq + 4 * SACK_MSS), (uint32_t *)&opts[16]);
+
+	ack = sack_data_seq;
+	peer_options = opts;
+	peer_options_len = sizeof(opts);
+	reply = prepare_ack_packet(af, htons(MY_PORT), dst_port);
+	peer_options = NULL;
+	peer_options_len = 0;
+
+	zassert_not_null(reply, "Cannot create pkt");
+	zassert_true(net_recv_data(net_iface, reply) == 0, "recv data failed");
+
+	t_state = T_FIN;
+	test_sem_give();
+}
+
+/* ACK the data received so far, with the blocks above the first hole */
+static void send_client_sack(sa_family_t af, uint16_t dst_port)
+{
+	uint8_t opts[2 + 2 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE];
+	struct net_pkt *reply;
+	int acked = 0;
+	int cnt = 0;
+	int i;
+
+	while (acked < SACK_SEGMENTS && sack_sent[acked] > 0 &&
+	       !(sack_lost[acked] && sack_sent[acked] == 1)) {
+		acked++;
+	}
+
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_SACK_OPT;
+
+	for (i = acked; i < SACK_SEGMENTS; i++) {
+		bool held = sack_sent[i] > 0 && !(sack_lost[i] && sack_sent[i] == 1);
+		uint32_t left = sack_data_seq + i * SACK_MSS;
+
+		if (!held) {
+			continue;
+		}
+
+		if (cnt > 0 && UNALIGNED_GET((uint32_t *)&opts[4 + (cnt - 1) * 8 + 4]) ==
+			       htonl(left)) {
+			UNALIGNED_PUT(htonl(left + SACK_MSS),
+				      (uint32_t *)&opts[4 + (cnt - 1) * 8 + 4]);
+			continue;
+		}
+
+		UNALIGNED_PUT(htonl(left), (uint32_t *)&opts[4 + cnt * 8]);
+		UNALIGNED_PUT(htonl(left + SACK_MSS), (uint32_t *)&opts[4 + cnt * 8 + 4]);
+		cnt++;
+	}
+
+	opts[3] = 2 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+
+	ack = sack_data_seq + acked * SACK_MSS;
+	if (cnt > 0) {
+		peer_options = opts;
+		peer_options_len = 4 + cnt * NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	reply = prepare_ack_packet(af, htons(MY_PORT), dst_port);
+	peer_options = NULL;
+	peer_options_len = 0;
+
+	zassert_not_null(reply, "Cannot create pkt");
+	zassert_true(net_recv_data(net_iface, reply) == 0, "recv data failed");
+
+	if (acked == SACK_SEGMENTS) {
+		t_state = T_FIN;
+		test_sem_give();
+	}
+}
+
+static void handle_client_sack(struct net_pkt *pkt)
+{
+	uint8_t opt[NET_TCP_SACK_PERM_SIZE];
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(&th, SYN);
+		zassert_equal(get_tcp_option(pkt, NET_TCP_SACK_PERM_OPT, opt, sizeof(opt)),
+			      NET_TCP_SACK_PERM_SIZE, "SACK not offered");
+		seq = 0U;
+		ack = ntohl(th.th_seq) + 1U;
+		sack_data_seq = ack;
+		sack_port = th.th_sport;
+		peer_options = sack_syn_ack_options;
+		peer_options_len = sizeof(sack_syn_ack_options);
+		reply = prepare_syn_ack_packet(net_pkt_family(pkt), htons(MY_PORT),
+					       th.th_sport);
+		peer_options = NULL;
+		peer_options_len = 0;
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, ACK);
+		seq++;
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		test_verify_flags(&th, PSH | ACK);
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+		zassert_equal(len, SACK_MSS, "Invalid segment size %zu", len);
+		zassert_equal((ntohl(th.th_seq) - sack_data_seq) % SACK_MSS, 0,
+			      "Invalid segment seq");
+
+		sack_sent[(ntohl(th.th_seq) - sack_data_seq) / SACK_MSS]++;
+		if (!sack_unsent) {
+			send_client_sack(net_pkt_family(pkt), th.th_sport);
+		} else if (sack_sent[SACK_WINDOW_SEGMENTS - 1] > 0) {
+			send_client_sack_unsent(net_pkt_family(pkt), th.th_sport);
+		}
+		return;
+	default:
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   the peer allows SACK in its SYN ACK,
+ *   send five segments, the first and the third are lost,
+ *   expect duplicate ACKs reporting the other segments in SACK blocks,
+ *   expect only the lost segments to be retransmitted.
+ */
+ZTEST(net_tcp, test_client_sack_retransmit)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	struct net_pkt *rst;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 19;
+	seq = ack = 0;
+	memset(sack_sent, 0, sizeof(sack_sent));
+	peer_window = htons(SACK_MSS * SACK_SEGMENTS * 2);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	/* Peer will release the semaphore after it receives
+	 * proper ACK to SYN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Put all the segments in flight at once */
+	conn->ca.cwnd = SACK_MSS * SACK_SEGMENTS;
+#endif
+
+	ret = net_context_send(ctx, lorem_ipsum, SACK_MSS * SACK_SEGMENTS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_MSS * SACK_SEGMENTS, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after it received all the data */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	for (int i = 0; i < SACK_SEGMENTS; i++) {
+		zassert_equal(sack_sent[i], sack_lost[i] ? 2 : 1,
+			      "Segment %d sent %d times", i, sack_sent[i]);
+	}
+
+	/* Abort the connection */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), sack_port);
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	peer_window = NET_IPV6_MTU;
+	net_context_put(ctx);
+}
+
+/* Test case scenario IPv4
+ *   the peer allows SACK in its SYN ACK,
+ *   queue five segments with a congestion window of two segments,
+ *   only the first two can be sent,
+ *   the peer reports the second and the fourth segment in SACK blocks,
+ *   expect the block of the fourth segment, which was never sent, to be
+ *   ignored.
+ */
+ZTEST(net_tcp, test_client_sack_unsent)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	struct net_pkt *rst;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	t_state = T_SYN;
+	test_case_no = 20;
+	seq = ack = 0;
+	memset(sack_sent, 0, sizeof(sack_sent));
+	sack_unsent = true;
+	peer_window = htons(SACK_MSS * SACK_SEGMENTS * 2);
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in), NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = ctx->tcp;
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+	/* Queue more data than may be put in flight */
+	conn->ca.cwnd = SACK_MSS * SACK_WINDOW_SEGMENTS;
+#endif
+
+	ret = net_context_send(ctx, lorem_ipsum, SACK_MSS * SACK_SEGMENTS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_MSS * SACK_SEGMENTS, "Failed to send data to peer");
+
+	/* Peer will release the semaphore after it sent the SACK blocks */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	zassert_equal(conn->unacked_len, SACK_MSS * SACK_WINDOW_SEGMENTS,
+		      "Unexpected data in flight %u", conn->unacked_len);
+	zassert_equal(conn->sacked_cnt, 1, "Unexpected SACK blocks %d", conn->sacked_cnt);
+	zassert_equal(conn->sacked[0].left, sack_data_seq + SACK_MSS, "Invalid SACK block");
+	zassert_equal(conn->sacked[0].right, sack_data_seq + 2 * SACK_MSS,
+		      "Invalid SACK block");
+
+	/* Abort the connection */
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), sack_port);
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	sack_unsent = false;
+	peer_window = NET_IPV6_MTU;
+	net_context_put(ctx);
+}
+#else
+static void handle_server_sack(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+
+static void handle_client_sack(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -913,7 +913,7 @@ ZTEST(test_utils_fn, test_ip_checksum)
 
 	/* Work across all possible combination so offset and length */
 	for (int offset = 0; offset < 7; offset++) {
-		for (int length = 1; length < 32; length++) {
+		for (int length = 1; length < 160; length++) {
 			sum_got = calc_chksum_ref(offset ^ 0x8e72, testdata + offset, length);
 			sum_exp = calc_chksum(offset ^ 0x8e72, testdata + offset, length);
 
@@ -923,4 +923,49 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+/* Data and its checksum add up to 0xffff, like in a valid packet */
+static bool chksum_is_valid(const uint8_t *data, size_t len, uint16_t chksum)
+{
+	return calc_chksum(calc_chksum(0, data, len), (uint8_t *)&chksum,
+			   sizeof(chksum)) == 0xffff;
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	uint16_t chksum;
+	uint16_t old16, new16;
+	uint32_t old32, new32;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	chksum = htons(~calc_chksum(0, testdata, 64));
+	zassert_true(chksum_is_valid(testdata, 64, chksum), "Invalid initial checksum");
+
+	/* Change a 16-bit word, including to all zeros and all ones */
+	for (int i = 0; i < 8; i++) {
+		memcpy(&old16, &testdata[10], sizeof(old16));
+		new16 = i == 0 ? 0x0000 : (i == 1 ? 0xffff : (uint16_t)(old16 * 31 + i));
+		memcpy(&testdata[10], &new16, sizeof(new16));
+
+		chksum = net_chksum_update16(chksum, old16, new16);
+
+		zassert_true(chksum_is_valid(testdata, 64, chksum),
+			     "Wrong checksum 0x%04x after 16-bit update %d", chksum, i);
+	}
+
+	/* Change a 32-bit word, like the TCP acknowledgment number */
+	for (int i = 0; i < 8; i++) {
+		memcpy(&old32, &testdata[20], sizeof(old32));
+		new32 = old32 * 2654435761U + i;
+		memcpy(&testdata[20], &new32, sizeof(new32));
+
+		chksum = net_chksum_update32(chksum, old32, new32);
+
+		zassert_true(chksum_is_valid(testdata, 64, chksum),
+			     "Wrong checksum 0x%04x after 32-bit update %d", chksum, i);
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
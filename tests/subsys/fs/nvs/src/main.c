@@ -934,3 +934,227 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_NVS_ID_INDEX
+static size_t num_index_entries_in_sector(uint32_t sector, struct nvs_fs *fs)
+{
+	size_t i, num = 0;
+
+	for (i = 0; i < CONFIG_NVS_ID_INDEX_SIZE; i++) {
+		if ((fs->id_index_ids[i] != 0xFFFF) &&
+		    ((fs->id_index_addr[i] >> ADDR_SECT_SHIFT) == sector)) {
+			num++;
+		}
+	}
+
+	return num;
+}
+#endif
+
+/*
+ * Test that the NVS ID index tracks writes, is rebuilt on nvs_mount() and
+ * answers lookups of missing IDs without walking the allocation tables.
+ */
+ZTEST_F(nvs, test_nvs_id_index)
+{
+#ifdef CONFIG_NVS_ID_INDEX
+	const uint16_t max_ids = CONFIG_NVS_ID_INDEX_SIZE * 3 / 4;
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.id_index_used, 0, "index not empty");
+	zassert_true(fixture->fs.id_index_complete, "empty index incomplete");
+
+	for (id = 0; id < max_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id * 7, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(fixture->fs.id_index_used, max_ids, "index not updated after write");
+	zassert_true(fixture->fs.id_index_complete, "index incomplete");
+
+	/* Rebuild the index from flash */
+
+	memset(fixture->fs.id_index_ids, 0xAA, sizeof(fixture->fs.id_index_ids));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.id_index_used, max_ids, "index not rebuilt");
+	zassert_true(fixture->fs.id_index_complete, "index incomplete after rebuild");
+
+	for (id = 0; id < max_ids; id++) {
+		err = nvs_read(&fixture->fs, id * 7, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+
+		err = nvs_read(&fixture->fs, id * 7 + 1, &data, sizeof(data));
+		zassert_equal(err, -ENOENT, "missing ID found");
+	}
+
+	/* Delete every other ID and update the others */
+
+	for (id = 0; id < max_ids; id++) {
+		if (id % 2) {
+			err = nvs_delete(&fixture->fs, id * 7);
+			zassert_true(err == 0, "nvs_delete call failure: %d", err);
+		} else {
+			data = id + 1;
+			err = nvs_write(&fixture->fs, id * 7, &data, sizeof(data));
+			zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		}
+	}
+
+	/* Keep writing ID 0 until sector 0 has been garbage collected */
+
+	data = 1;
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 0, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	data = 1;
+	err = nvs_write(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* Let the background gc erase sector 0 */
+	err = nvs_gc_wait(&fixture->fs);
+	zassert_true(err == 0, "nvs_gc_wait call failure: %d", err);
+#endif
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "index entries left in gc-ed sector");
+
+	for (id = 0; id < max_ids; id++) {
+		err = nvs_read(&fixture->fs, id * 7, &data, sizeof(data));
+		if (id % 2) {
+			zassert_equal(err, -ENOENT, "deleted ID found");
+		} else {
+			zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+			zassert_equal(data, id + 1, "incorrect data read");
+		}
+	}
+
+	/* Same result from an index rebuilt from flash */
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < max_ids; id++) {
+		err = nvs_read(&fixture->fs, id * 7, &data, sizeof(data));
+		if (id % 2) {
+			zassert_equal(err, -ENOENT, "deleted ID found after rebuild");
+		} else {
+			zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+			zassert_equal(data, id + 1, "incorrect data read after rebuild");
+		}
+	}
+#endif
+}
+
+/*
+ * Test that IDs that don't fit in the NVS ID index can still be read.
+ */
+ZTEST_F(nvs, test_nvs_id_index_overflow)
+{
+#ifdef CONFIG_NVS_ID_INDEX
+	const uint16_t num_ids = CONFIG_NVS_ID_INDEX_SIZE * 3 / 4 + 4;
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < num_ids; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_false(fixture->fs.id_index_complete, "overflowed index complete");
+
+	for (id = 0; id < num_ids; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	err = nvs_read(&fixture->fs, num_ids, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "missing ID found");
+#endif
+}
+
+/*
+ * Test that with background gc enabled sector changes happen off the write
+ * path and no data is lost across them.
+ */
+ZTEST_F(nvs, test_nvs_background_gc)
+{
+#if defined(CONFIG_NVS_BACKGROUND_GC) && defined(CONFIG_NVS_GC_STATS)
+	int err;
+	uint16_t data = 0;
+	uint16_t sector_changes = 0;
+	uint32_t sector;
+	struct nvs_gc_stats stats;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	nvs_gc_stats_reset(&fixture->fs);
+
+	/* A value that has to survive every gc */
+	err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+	while (sector_changes < 2 * fixture->fs.sector_count) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+		/* Let the background gc catch up before the next write */
+		err = nvs_gc_wait(&fixture->fs);
+		zassert_true(err == 0, "nvs_gc_wait call failure: %d", err);
+
+		if ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+			sector = fixture->fs.ate_wra >> ADDR_SECT_SHIFT;
+			sector_changes++;
+		}
+	}
+
+	err = nvs_gc_stats_get(&fixture->fs, &stats);
+	zassert_true(err == 0, "nvs_gc_stats_get call failure: %d", err);
+	TC_PRINT("gc runs %u, bytes moved %u, sync copies %u, sync erases %u, "
+		 "max write %u us\n", stats.gc_runs, stats.bytes_moved, stats.sync_copies,
+		 stats.sync_erases, stats.max_write_us);
+
+	/* On the first sector change the sector after the new one was never
+	 * written, so there is nothing to collect yet.
+	 */
+	zassert_equal(stats.gc_runs, sector_changes - 1, "unexpected gc runs");
+	zassert_true(stats.bytes_moved > 0, "no data moved by gc");
+	zassert_equal(stats.sync_copies, 0, "writer had to copy");
+	zassert_equal(stats.sync_erases, 0, "writer had to erase");
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	err = nvs_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 0, "incorrect data read");
+
+	/* Interrupt the background gc at whatever state it is in */
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	err = nvs_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+	zassert_equal(data, 0, "incorrect data read after remount");
+#endif
+}
@@ -509,6 +509,86 @@ ZTEST_USER(rtio_api, test_rtio_multishot)
 	}
 }
 
+RTIO_DEFINE(r_batch, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+RTIO_IODEV_TEST_DEFINE(iodev_test_batch);
+
+/**
+ * @brief Test a multishot write
+ *
+ * Ensures a write flagged as multishot keeps producing completions for the
+ * same buffer until it is canceled.
+ */
+ZTEST(rtio_api, test_rtio_multishot_write)
+{
+	static uint8_t tx_data[MEM_BLK_SIZE];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe cqe;
+
+	rtio_iodev_test_init(&iodev_test_batch);
+
+	sqe = rtio_sqe_acquire(&r_batch);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_write_multishot(sqe, (struct rtio_iodev *)&iodev_test_batch, 0, tx_data,
+				      sizeof(tx_data), tx_data);
+	zassert_ok(rtio_submit(&r_batch, 0));
+
+	for (int i = 0; i < TEST_REPEATS; i++) {
+		zassert_equal(1, rtio_cqe_copy_out(&r_batch, &cqe, 1, K_MSEC(100)),
+			      "Expected a completion for write %d", i);
+		zassert_equal_ptr(cqe.userdata, tx_data, "Expected userdata back");
+	}
+
+	zassert_ok(rtio_sqe_cancel(sqe));
+	/* Flush any pending CQEs */
+	while (rtio_cqe_copy_out(&r_batch, &cqe, 1, K_MSEC(15)) != 0) {
+	}
+}
+
+/**
+ * @brief Test consuming a batch of completions
+ *
+ * Ensures completions can be waited for and consumed as a batch.
+ */
+ZTEST(rtio_api, test_rtio_cqe_consume_batch)
+{
+	uintptr_t userdata[SQE_POOL_SIZE];
+	struct rtio_cqe *cqes[CQE_POOL_SIZE + 1];
+	struct rtio_sqe *sqe;
+	size_t count;
+
+	rtio_iodev_test_init(&iodev_test_batch);
+
+	for (int i = 0; i < SQE_POOL_SIZE; i++) {
+		sqe = rtio_sqe_acquire(&r_batch);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_batch, &userdata[i]);
+	}
+
+#ifdef CONFIG_RTIO_CQE_WAIT_SEM
+	zassert_ok(rtio_submit(&r_batch, 0));
+
+	/* The test iodev takes 10ms for each request */
+	zassert_equal(-EBUSY, rtio_cqe_wait(&r_batch, SQE_POOL_SIZE, K_NO_WAIT));
+	zassert_equal(-EAGAIN, rtio_cqe_wait(&r_batch, SQE_POOL_SIZE, K_MSEC(5)));
+	zassert_ok(rtio_cqe_wait(&r_batch, SQE_POOL_SIZE, K_MSEC(500)));
+	zassert_ok(rtio_cqe_wait(&r_batch, SQE_POOL_SIZE, K_NO_WAIT),
+		   "Completions must remain available until consumed");
+#else
+	zassert_ok(rtio_submit(&r_batch, SQE_POOL_SIZE));
+#endif
+
+	count = rtio_cqe_consume_batch(&r_batch, cqes, ARRAY_SIZE(cqes));
+	zassert_equal(count, SQE_POOL_SIZE, "Expected all completions, got %zu", count);
+	for (int i = 0; i < count; i++) {
+		zassert_ok(cqes[i]->result, "Result should be ok");
+		zassert_equal_ptr(cqes[i]->userdata, &userdata[i], "Expected completions in order");
+		rtio_cqe_release(&r_batch, cqes[i]);
+	}
+
+	zassert_equal(0, rtio_cqe_consume_batch(&r_batch, cqes, ARRAY_SIZE(cqes)));
+}
+
 RTIO_DEFINE(r_transaction, SQE_POOL_SIZE, CQE_POOL_SIZE);
 
 RTIO_IODEV_TEST_DEFINE(iodev_test_transaction0);
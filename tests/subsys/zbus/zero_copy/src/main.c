@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+#define INVALID_SEQ 0xFFFFFFFFU
+
+struct frame_msg {
+	uint32_t seq;
+	uint8_t payload[1024];
+};
+
+static bool frame_validator(const void *msg, size_t msg_size)
+{
+	ARG_UNUSED(msg_size);
+
+	return ((const struct frame_msg *)msg)->seq != INVALID_SEQ;
+}
+
+ZBUS_CHAN_DEFINE(frame_chan,       /* Name */
+		 struct frame_msg, /* Message type */
+
+		 frame_validator,                           /* Validator */
+		 NULL,                                      /* User data */
+		 ZBUS_OBSERVERS(frame_lis, msub1, msub2, sub), /* observers */
+		 ZBUS_MSG_INIT(0)                           /* Initial value */
+);
+
+static const void *lis_data;
+static uint32_t lis_seq;
+
+static void frame_lis_cb(const struct zbus_channel *chan)
+{
+	const struct net_buf *buf = zbus_chan_const_buf(chan);
+
+	lis_data = (buf != NULL) ? buf->data : NULL;
+	lis_seq = (buf != NULL) ? ((const struct frame_msg *)buf->data)->seq
+				: ((const struct frame_msg *)zbus_chan_const_msg(chan))->seq;
+}
+
+ZBUS_LISTENER_DEFINE(frame_lis, frame_lis_cb);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub2);
+ZBUS_SUBSCRIBER_DEFINE(sub, 4);
+
+static struct net_buf *publish(uint32_t seq)
+{
+	struct net_buf *buf = zbus_chan_buf_alloc(&frame_chan, K_NO_WAIT);
+
+	zassert_not_null(buf, "allocation failed");
+	zassert_equal(buf->len, sizeof(struct frame_msg), "buffer must hold one message");
+
+	((struct frame_msg *)buf->data)->seq = seq;
+	memset(((struct frame_msg *)buf->data)->payload, seq, sizeof(struct frame_msg) - 4);
+
+	return buf;
+}
+
+static void check_received(const struct zbus_observer *sub, const void *data, uint32_t seq)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	zassert_equal(0, zbus_sub_wait_buf(sub, &chan, &buf, K_MSEC(100)), NULL);
+	zassert_equal_ptr(chan, &frame_chan, NULL);
+	zassert_equal(((struct frame_msg *)buf->data)->seq, seq, NULL);
+	if (data != NULL) {
+		zassert_equal_ptr(buf->data, data, "message must not be copied");
+	}
+	net_buf_unref(buf);
+}
+
+ZTEST(zero_copy, test_pub_buf)
+{
+	/* More publications than buffers in the pool, nothing may leak */
+	for (uint32_t seq = 1; seq <= 3 * CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE; seq++) {
+		struct net_buf *buf = publish(seq);
+		const void *data = buf->data;
+
+		zassert_equal(0, zbus_chan_pub_buf(&frame_chan, buf, K_MSEC(100)), NULL);
+
+		zassert_equal_ptr(lis_data, data, "listener must see the published data");
+		zassert_equal(lis_seq, seq, NULL);
+
+		check_received(&msub1, data, seq);
+		check_received(&msub2, data, seq);
+	}
+
+	zassert_is_null(zbus_chan_const_buf(&frame_chan), "buffer exposed after publication");
+}
+
+ZTEST(zero_copy, test_pub_buf_invalid)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	for (int i = 0; i < 2 * CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE; i++) {
+		zassert_equal(-ENOMSG, zbus_chan_pub_buf(&frame_chan, publish(INVALID_SEQ), K_NO_WAIT),
+			      "invalid message must be rejected");
+	}
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_buf(&msub1, &chan, &buf, K_NO_WAIT), NULL);
+}
+
+ZTEST(zero_copy, test_pub_copy)
+{
+	const struct zbus_channel *chan;
+	struct frame_msg msg = {.seq = 100};
+
+	/* Publications by copy are received through the same API */
+	zassert_equal(0, zbus_chan_pub(&frame_chan, &msg, K_MSEC(100)), NULL);
+
+	zassert_is_null(lis_data, "copy publication must not expose a buffer");
+	zassert_equal(lis_seq, msg.seq, NULL);
+
+	check_received(&msub1, NULL, msg.seq);
+	check_received(&msub2, NULL, msg.seq);
+
+	zassert_equal(0, zbus_sub_wait(&sub, &chan, K_NO_WAIT), "subscriber must be notified");
+	zassert_equal_ptr(chan, &frame_chan, NULL);
+}
+
+ZTEST(zero_copy, test_pub_buf_subscriber)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf = publish(200);
+
+	/* The channel is not updated, so subscribers have nothing to read */
+	zassert_equal(0, zbus_chan_pub_buf(&frame_chan, buf, K_MSEC(100)), NULL);
+	zassert_equal(-ENOMSG, zbus_sub_wait(&sub, &chan, K_NO_WAIT),
+		      "subscriber must not be notified");
+
+	check_received(&msub1, NULL, 200);
+	check_received(&msub2, NULL, 200);
+}
+
+ZTEST_SUITE(zero_copy, NULL, NULL, NULL, NULL, NULL);
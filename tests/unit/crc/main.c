@@ -11,6 +11,9 @@
 #include "../../../lib/crc/crc32_sw.c"
 #include "../../../lib/crc/crc32c_sw.c"
 #include "../../../lib/crc/crc7_sw.c"
+#ifdef CONFIG_CRC32_BACKEND
+#include "../../../lib/crc/crc32_backend.c"
+#endif
 
 ZTEST(crc, test_crc32c)
 {
@@ -50,6 +53,91 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+/* Bit-at-a-time reference for the reflected CRC32 algorithms */
+static uint32_t crc32_reflected_ref(uint32_t poly, uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+		}
+	}
+
+	return ~crc;
+}
+
+ZTEST(crc, test_crc32_long_unaligned)
+{
+	static uint8_t buf[300];
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	/* Exercise the word-at-a-time paths with every alignment and
+	 * tail length
+	 */
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = sizeof(buf) - 16; len < sizeof(buf) - 8; len++) {
+			zassert_equal(crc32_ieee(buf + off, len),
+				      crc32_reflected_ref(0xEDB88320, 0, buf + off, len));
+			zassert_equal(crc32_c(0, buf + off, len, true, true),
+				      crc32_reflected_ref(0x82F63B78, 0, buf + off, len));
+		}
+	}
+
+	/* Streaming in uneven chunks matches a single pass */
+	zassert_equal(crc32_ieee_update(crc32_ieee(buf, 13), buf + 13, sizeof(buf) - 13),
+		      crc32_ieee(buf, sizeof(buf)));
+}
+
+#ifdef CONFIG_CRC32_BACKEND
+static uint32_t backend_calls;
+
+static uint32_t backend_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	backend_calls++;
+	return ~crc32_reflected_ref(0xEDB88320, ~crc, data, len);
+}
+
+static uint32_t backend_c_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	backend_calls++;
+	return ~crc32_reflected_ref(0x82F63B78, ~crc, data, len);
+}
+
+ZTEST(crc, test_crc32_backend)
+{
+	static const struct crc32_backend backend = {
+		.ieee_update = backend_ieee_update,
+		.c_update = backend_c_update,
+	};
+	static const struct crc32_backend ieee_only = {
+		.ieee_update = backend_ieee_update,
+	};
+	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+	backend_calls = 0;
+	crc32_backend_register(&backend);
+
+	zassert_equal(crc32_ieee(test, sizeof(test)), 0xCBF43926);
+	zassert_equal(crc32_c(0, test, sizeof(test), true, true), 0xE3069283);
+	zassert_equal(crc32_c(crc32_c(0, test, 4, true, false), test + 4,
+			      sizeof(test) - 4, false, true), 0xE3069283);
+	zassert_equal(backend_calls, 4);
+
+	/* A missing member falls back to the built-in implementation */
+	crc32_backend_register(&ieee_only);
+	zassert_equal(crc32_c(0, test, sizeof(test), true, true), 0xE3069283);
+	zassert_equal(backend_calls, 4);
+
+	crc32_backend_register(NULL);
+	zassert_equal(crc32_ieee(test, sizeof(test)), 0xCBF43926);
+	zassert_equal(backend_calls, 4);
+}
+#endif
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };